@@ -0,0 +1,705 @@
+#ifndef BPLUS_TREE_HPP
+# define BPLUS_TREE_HPP
+
+# include <cstddef>
+# include <memory>
+# include <stdexcept>
+# include "../utils/pair.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/type_traits.hpp"
+# include "bpt_bidirectional_iterator.hpp"
+
+namespace ft
+{
+	template<class T>
+	struct bpt_mapped_type {
+		typedef T type;
+	};
+
+	template<class T1, class T2>
+	struct bpt_mapped_type<ft::pair<T1, T2> > {
+		typedef T2 type;
+	};
+
+	// Leaves hold the keys inline, so a search reads one node per level,
+	// and pointers to the elements, which are allocated one by one and
+	// never move. Keys are constructed in place, so they need not be
+	// default-constructible.
+	template<class Key, class T, std::size_t Capacity>
+	struct bpt_leaf_node {
+		typedef Key																	key_type;
+		typedef T																	value_type;
+		std::size_t																	count;
+		bpt_leaf_node*																prev;
+		bpt_leaf_node*																next;
+		value_type*																	values[Capacity];
+		typename aligned_storage<Capacity * sizeof(Key), alignment_of<Key>::value>::type	storage;
+
+		key_type* keys(void) {
+			return reinterpret_cast<key_type*>(storage.data);
+		}
+
+		const key_type* keys(void) const {
+			return reinterpret_cast<const key_type*>(storage.data);
+		}
+	};
+
+	template<class Key, std::size_t Capacity>
+	struct bpt_inner_node {
+		typedef Key																		key_type;
+		std::size_t																		count;
+		void*																			children[Capacity];
+		typename aligned_storage<(Capacity - 1) * sizeof(Key), alignment_of<Key>::value>::type	storage;
+
+		key_type* keys(void) {
+			return reinterpret_cast<key_type*>(storage.data);
+		}
+
+		const key_type* keys(void) const {
+			return reinterpret_cast<const key_type*>(storage.data);
+		}
+	};
+
+	// B+-tree with the same interface as red_black_tree, usable as the Tree
+	// parameter of ft::map and ft::set. Leaves are linked for iteration and
+	// hold the keys and the elements; inner nodes hold separator keys.
+	// NodeBytes is the target size of a node, so a lookup touches one node
+	// per level instead of one per comparison.
+	//
+	// Each element has a node of its own, so insert and erase move keys and
+	// pointers between slots but never an element: references stay valid as
+	// in red_black_tree, and iterators, which keep the element, find their
+	// slot again after a change (see bpt_bidirectional_iterator). Leaves are
+	// released when they become empty rather than merged, which keeps erase
+	// simple at the price of some slack.
+	template<class Key, class Value, class KeyOfValue, class Compare = less<Key>,
+			class Allocator = std::allocator<Value>, std::size_t NodeBytes = 256>
+	class bplus_tree {
+	public:
+		typedef Key																key_type;
+		typedef Value															value_type;
+		typedef typename bpt_mapped_type<Value>::type							mapped_type;
+		typedef Compare															key_compare;
+		typedef Allocator														allocator_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+
+		static const size_type leaf_header = sizeof(size_type) + 2 * sizeof(void*);
+		static const size_type leaf_slot = sizeof(Key) + sizeof(void*);
+		static const size_type leaf_capacity = (NodeBytes > leaf_header + 3 * leaf_slot)
+												? (NodeBytes - leaf_header) / leaf_slot : 3;
+		static const size_type inner_capacity = (NodeBytes > sizeof(size_type) + 4 * (sizeof(Key) + sizeof(void*)))
+												? (NodeBytes - sizeof(size_type)) / (sizeof(Key) + sizeof(void*)) : 4;
+
+		typedef bpt_leaf_node<key_type, value_type, leaf_capacity>				leaf_type;
+		typedef bpt_inner_node<key_type, inner_capacity>						inner_type;
+		typedef ft::bpt_bidirectional_iterator<leaf_type, bplus_tree>			iterator;
+		typedef ft::bpt_bidirectional_iterator<const leaf_type, const bplus_tree>	const_iterator;
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+
+	private:
+		template<class, class> friend class bpt_bidirectional_iterator;
+
+		typedef typename Allocator::template rebind<leaf_type>::other			leaf_allocator;
+		typedef typename Allocator::template rebind<inner_type>::other			inner_allocator;
+		typedef typename Allocator::template rebind<key_type>::other			key_allocator;
+
+		// Deep enough for any tree that fits in memory: each level multiplies
+		// the number of leaves by at least inner_capacity / 2.
+		static const size_type max_height = 64;
+
+		void*			_root;
+		size_type		_height;
+		leaf_type*		_first;
+		leaf_type*		_last;
+		key_compare		_comp;
+		size_type		_size;
+		// Changes whenever slots may have moved; iterators compare it with
+		// their own to know when to find their slot again.
+		size_type		_version;
+		allocator_type	_alloc;
+		leaf_allocator	_leaf_alloc;
+		inner_allocator	_inner_alloc;
+		key_allocator	_key_alloc;
+		KeyOfValue		_key_of;
+
+	public:
+		explicit bplus_tree(const key_compare& comp = key_compare(),
+							const allocator_type& alloc = allocator_type()) :	_root(0), _height(0), _first(0),
+																				_last(0), _comp(comp), _size(0),
+																				_version(0), _alloc(alloc),
+																				_leaf_alloc(alloc), _inner_alloc(alloc),
+																				_key_alloc(alloc) {}
+
+		template<class InputIt>
+		bplus_tree(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+					const allocator_type& alloc = allocator_type()) :	_root(0), _height(0), _first(0),
+																		_last(0), _comp(comp), _size(0),
+																		_version(0), _alloc(alloc),
+																		_leaf_alloc(alloc), _inner_alloc(alloc),
+																		_key_alloc(alloc) {
+			insert(first, last);
+		}
+
+		bplus_tree(const bplus_tree& other) :	_root(0), _height(0), _first(0), _last(0),
+												_comp(other._comp), _size(0), _version(0),
+												_alloc(other._alloc), _leaf_alloc(other._leaf_alloc),
+												_inner_alloc(other._inner_alloc), _key_alloc(other._key_alloc) {
+			insert(other.begin(), other.end());
+		}
+
+		virtual ~bplus_tree(void) {
+			clear();
+		}
+
+		bplus_tree& operator=(const bplus_tree& other) {
+			if (this == &other) {
+				return *this;
+			}
+			clear();
+			_comp = other._comp;
+			insert(other.begin(), other.end());
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		mapped_type& at(const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return it._leaf->values[it._index]->second;
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			const_iterator it = find(key);
+			if (it == end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return it._leaf->values[it._index]->second;
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				it = insert(value_type(key, mapped_type())).first;
+			}
+			return it._leaf->values[it._index]->second;
+		}
+
+		iterator begin(void) {
+			return iterator(_first, 0, this);
+		}
+
+		const_iterator begin(void) const {
+			return const_iterator(_first, 0, this);
+		}
+
+		iterator end(void) {
+			return iterator(0, 0, this);
+		}
+
+		const_iterator end(void) const {
+			return const_iterator(0, 0, this);
+		}
+
+		reverse_iterator rbegin(void) {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend(void) {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend(void) const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool empty(void) const {
+			return _size == 0;
+		}
+
+		size_type size(void) const {
+			return _size;
+		}
+
+		size_type max_size(void) const {
+			return _alloc.max_size();
+		}
+
+		void clear(void) {
+			if (_root) {
+				_clear_help(_root, _height);
+			}
+			_root = 0;
+			_height = 0;
+			_first = 0;
+			_last = 0;
+			_size = 0;
+			++_version;
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			inner_type*	path[max_height];
+			size_type	slots[max_height];
+			const key_type& key = _key_of(value);
+			if (!_root) {
+				_root = _create_leaf();
+				_first = static_cast<leaf_type*>(_root);
+				_last = _first;
+			}
+			leaf_type* leaf = _descend(key, path, slots);
+			size_type pos = _leaf_lower_bound(leaf, key);
+			if (pos < leaf->count && !_comp(key, leaf->keys()[pos])) {
+				return ft::make_pair(iterator(leaf, pos, this), false);
+			}
+			++_version;
+			if (leaf->count < leaf_capacity) {
+				_leaf_insert_at(leaf, pos, value);
+				++_size;
+				return ft::make_pair(iterator(leaf, pos, this), true);
+			}
+			leaf_type* right = _split_leaf(leaf);
+			iterator it;
+			if (pos <= leaf->count) {
+				_leaf_insert_at(leaf, pos, value);
+				it = iterator(leaf, pos, this);
+			} else {
+				_leaf_insert_at(right, pos - leaf->count, value);
+				it = iterator(right, pos - leaf->count, this);
+			}
+			++_size;
+			_insert_into_parent(path, slots, _height, leaf, right->keys()[0], right);
+			return ft::make_pair(it, true);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last,
+					typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = 0) {
+			while (first != last) {
+				insert(*first);
+				++first;
+			}
+		}
+
+		void erase(iterator pos) {
+			if (pos != end()) {
+				_erase_at(pos);
+			}
+		}
+
+		void erase(iterator first, iterator last) {
+			while (first != last) {
+				first = _erase_at(first);
+			}
+		}
+
+		size_type erase(const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				return 0;
+			}
+			erase(it);
+			return 1;
+		}
+
+		size_type count(const key_type& key) const {
+			if (find(key) != end()) {
+				return 1;
+			}
+			return 0;
+		}
+
+		iterator find(const key_type& key) {
+			if (!_root) {
+				return end();
+			}
+			leaf_type* leaf = _find_leaf(key);
+			size_type pos = _leaf_lower_bound(leaf, key);
+			if (pos == leaf->count || _comp(key, leaf->keys()[pos])) {
+				return end();
+			}
+			return iterator(leaf, pos, this);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return const_cast<bplus_tree*>(this)->find(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			return ft::make_pair<iterator, iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			return ft::make_pair<const_iterator, const_iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		iterator lower_bound(const key_type& key) {
+			if (!_root) {
+				return end();
+			}
+			leaf_type* leaf = _find_leaf(key);
+			return _leaf_position(leaf, _leaf_lower_bound(leaf, key));
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			return const_cast<bplus_tree*>(this)->lower_bound(key);
+		}
+
+		iterator upper_bound(const key_type& key) {
+			if (!_root) {
+				return end();
+			}
+			leaf_type* leaf = _find_leaf(key);
+			return _leaf_position(leaf, _leaf_upper_bound(leaf, key));
+		}
+
+		const_iterator upper_bound(const key_type& key) const {
+			return const_cast<bplus_tree*>(this)->upper_bound(key);
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+	private:
+		void _clear_help(void* node, size_type height) {
+			if (height == 0) {
+				leaf_type* leaf = static_cast<leaf_type*>(node);
+				for (size_type i = 0; i < leaf->count; ++i) {
+					_key_alloc.destroy(leaf->keys() + i);
+					_delete_value(leaf->values[i]);
+				}
+				_leaf_alloc.deallocate(leaf, 1);
+				return ;
+			}
+			inner_type* inner = static_cast<inner_type*>(node);
+			for (size_type i = 0; i < inner->count; ++i) {
+				_clear_help(inner->children[i], height - 1);
+			}
+			_delete_inner(inner);
+		}
+
+		value_type* _create_value(const value_type& value) {
+			value_type* node = _alloc.allocate(1);
+			try {
+				_alloc.construct(node, value);
+			} catch (...) {
+				_alloc.deallocate(node, 1);
+				throw;
+			}
+			return node;
+		}
+
+		void _delete_value(value_type* node) {
+			_alloc.destroy(node);
+			_alloc.deallocate(node, 1);
+		}
+
+		leaf_type* _create_leaf(void) {
+			leaf_type* leaf = _leaf_alloc.allocate(1);
+			leaf->count = 0;
+			leaf->prev = 0;
+			leaf->next = 0;
+			return leaf;
+		}
+
+		inner_type* _create_inner(void) {
+			inner_type* inner = _inner_alloc.allocate(1);
+			inner->count = 0;
+			return inner;
+		}
+
+		void _delete_inner(inner_type* inner) {
+			for (size_type i = 0; i + 1 < inner->count; ++i) {
+				_key_alloc.destroy(inner->keys() + i);
+			}
+			_inner_alloc.deallocate(inner, 1);
+		}
+
+		// Index of the child whose range holds key: the first separator
+		// greater than key.
+		size_type _child_index(const inner_type* inner, const key_type& key) const {
+			size_type lo = 0;
+			size_type hi = inner->count - 1;
+			while (lo < hi) {
+				size_type mid = lo + (hi - lo) / 2;
+				if (_comp(key, inner->keys()[mid])) {
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo;
+		}
+
+		size_type _leaf_lower_bound(const leaf_type* leaf, const key_type& key) const {
+			size_type lo = 0;
+			size_type hi = leaf->count;
+			while (lo < hi) {
+				size_type mid = lo + (hi - lo) / 2;
+				if (_comp(leaf->keys()[mid], key)) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		size_type _leaf_upper_bound(const leaf_type* leaf, const key_type& key) const {
+			size_type lo = 0;
+			size_type hi = leaf->count;
+			while (lo < hi) {
+				size_type mid = lo + (hi - lo) / 2;
+				if (_comp(key, leaf->keys()[mid])) {
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo;
+		}
+
+		// Every element of a leaf's successors is not less than the separator
+		// that routed us here, so a position past the end of the leaf is the
+		// first element of the next one.
+		iterator _leaf_position(leaf_type* leaf, size_type pos) {
+			if (pos == leaf->count) {
+				return iterator(leaf->next, 0, this);
+			}
+			return iterator(leaf, pos, this);
+		}
+
+		// The slot of an element in the tree, for iterators made before the
+		// last change.
+		leaf_type* _locate(const value_type& value, size_type& index) const {
+			const key_type& key = _key_of(value);
+			leaf_type* leaf = _find_leaf(key);
+			index = _leaf_lower_bound(leaf, key);
+			return leaf;
+		}
+
+		leaf_type* _find_leaf(const key_type& key) const {
+			void* node = _root;
+			for (size_type h = _height; h > 0; --h) {
+				inner_type* inner = static_cast<inner_type*>(node);
+				node = inner->children[_child_index(inner, key)];
+			}
+			return static_cast<leaf_type*>(node);
+		}
+
+		leaf_type* _descend(const key_type& key, inner_type** path, size_type* slots) const {
+			void* node = _root;
+			for (size_type h = 0; h < _height; ++h) {
+				inner_type* inner = static_cast<inner_type*>(node);
+				path[h] = inner;
+				slots[h] = _child_index(inner, key);
+				node = inner->children[slots[h]];
+			}
+			return static_cast<leaf_type*>(node);
+		}
+
+		// Moves the key of slot from into slot to, which holds none.
+		void _move_key(key_type* keys, size_type from, size_type to) {
+			_key_alloc.construct(keys + to, keys[from]);
+			_key_alloc.destroy(keys + from);
+		}
+
+		void _leaf_insert_at(leaf_type* leaf, size_type pos, const value_type& value) {
+			value_type* node = _create_value(value);
+			key_type* keys = leaf->keys();
+			for (size_type i = leaf->count; i > pos; --i) {
+				_move_key(keys, i - 1, i);
+				leaf->values[i] = leaf->values[i - 1];
+			}
+			_key_alloc.construct(keys + pos, _key_of(*node));
+			leaf->values[pos] = node;
+			++leaf->count;
+		}
+
+		void _leaf_erase_at(leaf_type* leaf, size_type pos) {
+			key_type* keys = leaf->keys();
+			_delete_value(leaf->values[pos]);
+			_key_alloc.destroy(keys + pos);
+			for (size_type i = pos + 1; i < leaf->count; ++i) {
+				_move_key(keys, i, i - 1);
+				leaf->values[i - 1] = leaf->values[i];
+			}
+			--leaf->count;
+		}
+
+		// Moves the upper half of a full leaf into a new right sibling.
+		leaf_type* _split_leaf(leaf_type* leaf) {
+			leaf_type* right = _create_leaf();
+			size_type split = leaf->count / 2;
+			for (size_type i = split; i < leaf->count; ++i) {
+				_key_alloc.construct(right->keys() + (i - split), leaf->keys()[i]);
+				_key_alloc.destroy(leaf->keys() + i);
+				right->values[i - split] = leaf->values[i];
+			}
+			right->count = leaf->count - split;
+			leaf->count = split;
+			right->prev = leaf;
+			right->next = leaf->next;
+			if (leaf->next) {
+				leaf->next->prev = right;
+			} else {
+				_last = right;
+			}
+			leaf->next = right;
+			return right;
+		}
+
+		// Puts separator key and child right after child slot of inner.
+		void _inner_insert_at(inner_type* inner, size_type slot, const key_type& key, void* child) {
+			key_type* keys = inner->keys();
+			for (size_type i = inner->count - 1; i > slot; --i) {
+				_move_key(keys, i - 1, i);
+				inner->children[i + 1] = inner->children[i];
+			}
+			_key_alloc.construct(keys + slot, key);
+			inner->children[slot + 1] = child;
+			++inner->count;
+		}
+
+		// Removes child slot of inner together with the separator bounding it.
+		void _inner_erase_at(inner_type* inner, size_type slot) {
+			key_type* keys = inner->keys();
+			if (inner->count > 1) {
+				size_type k = slot ? slot - 1 : 0;
+				_key_alloc.destroy(keys + k);
+				for (size_type i = k + 1; i + 1 < inner->count; ++i) {
+					_move_key(keys, i, i - 1);
+				}
+			}
+			for (size_type i = slot + 1; i < inner->count; ++i) {
+				inner->children[i - 1] = inner->children[i];
+			}
+			--inner->count;
+		}
+
+		// Links right as the sibling following left, whose parent is
+		// path[depth - 1], splitting full inner nodes on the way up.
+		void _insert_into_parent(inner_type** path, size_type* slots, size_type depth,
+								void* left, const key_type& key, void* right) {
+			if (depth == 0) {
+				inner_type* root = _create_inner();
+				root->children[0] = left;
+				root->children[1] = right;
+				_key_alloc.construct(root->keys(), key);
+				root->count = 2;
+				_root = root;
+				++_height;
+				return ;
+			}
+			inner_type* parent = path[depth - 1];
+			size_type slot = slots[depth - 1];
+			if (parent->count < inner_capacity) {
+				_inner_insert_at(parent, slot, key, right);
+				return ;
+			}
+			size_type half = parent->count / 2;
+			inner_type* sibling = _create_inner();
+			key_type up(parent->keys()[half - 1]);
+			for (size_type i = half; i < parent->count; ++i) {
+				sibling->children[i - half] = parent->children[i];
+				if (i + 1 < parent->count) {
+					_key_alloc.construct(sibling->keys() + (i - half), parent->keys()[i]);
+					_key_alloc.destroy(parent->keys() + i);
+				}
+			}
+			_key_alloc.destroy(parent->keys() + (half - 1));
+			sibling->count = parent->count - half;
+			parent->count = half;
+			if (slot < half) {
+				_inner_insert_at(parent, slot, key, right);
+			} else {
+				_inner_insert_at(sibling, slot - half, key, right);
+			}
+			_insert_into_parent(path, slots, depth - 1, parent, up, sibling);
+		}
+
+		// pos may predate the last change, so its slot is found again on the
+		// way down.
+		iterator _erase_at(iterator pos) {
+			inner_type*	path[max_height];
+			size_type	slots[max_height];
+			leaf_type* leaf = _descend(_key_of(*pos), path, slots);
+			size_type index = _leaf_lower_bound(leaf, _key_of(*pos));
+			++_version;
+			_leaf_erase_at(leaf, index);
+			--_size;
+			if (leaf->count) {
+				return _leaf_position(leaf, index);
+			}
+			leaf_type* next = leaf->next;
+			_remove_leaf(leaf, path, slots);
+			return iterator(next, 0, this);
+		}
+
+		void _remove_leaf(leaf_type* leaf, inner_type** path, size_type* slots) {
+			if (leaf->prev) {
+				leaf->prev->next = leaf->next;
+			} else {
+				_first = leaf->next;
+			}
+			if (leaf->next) {
+				leaf->next->prev = leaf->prev;
+			} else {
+				_last = leaf->prev;
+			}
+			_leaf_alloc.deallocate(leaf, 1);
+			size_type depth = _height;
+			while (depth > 0) {
+				inner_type* parent = path[depth - 1];
+				_inner_erase_at(parent, slots[depth - 1]);
+				if (parent->count) {
+					break;
+				}
+				_delete_inner(parent);
+				--depth;
+			}
+			if (depth == 0) {
+				_root = 0;
+				_height = 0;
+				return ;
+			}
+			while (_height > 0 && static_cast<inner_type*>(_root)->count == 1) {
+				inner_type* old_root = static_cast<inner_type*>(_root);
+				_root = old_root->children[0];
+				_delete_inner(old_root);
+				--_height;
+			}
+		}
+	};
+
+	// Spellings of bplus_tree for the Tree parameter of ft::map and ft::set.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> >, std::size_t NodeBytes = 256>
+	struct bplus_map_tree {
+		typedef bplus_tree<Key, pair<const Key, T>, select_first<pair<const Key, T> >,
+							Compare, Allocator, NodeBytes>						type;
+	};
+
+	template<class Key, class Compare = less<Key>,
+			class Allocator = std::allocator<Key>, std::size_t NodeBytes = 256>
+	struct bplus_set_tree {
+		typedef bplus_tree<Key, Key, identity<Key>, Compare, Allocator, NodeBytes>	type;
+	};
+}
+
+#endif
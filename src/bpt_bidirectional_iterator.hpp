@@ -0,0 +1,161 @@
+#ifndef BPT_BIDIRECTIONAL_ITERATOR_HPP
+# define BPT_BIDIRECTIONAL_ITERATOR_HPP
+
+# include <cstddef> // ptrdiff_t
+# include <iterator> //std::bidirectional_iterator_tag
+# include "../utils/reverse_iterator.hpp"
+
+namespace ft
+{
+	// Walks the linked leaf level of a bplus_tree. A position is a leaf and
+	// a slot inside it; end() is the null leaf, so stepping back from it
+	// needs the tree's last leaf.
+	//
+	// Elements have nodes of their own that never move, but their slots
+	// shift when the tree changes. The iterator holds the element and the
+	// tree's version from when the slot was right; if the tree has changed
+	// since, a step first finds the slot again by the element's key. So,
+	// as with std::map, only erasing an element invalidates iterators to it.
+	template<class Leaf, class Tree>
+	class bpt_bidirectional_iterator {
+	public:
+		typedef Leaf								node_type;
+		typedef node_type*							node_ptr;
+		typedef typename Leaf::value_type			value_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef typename Leaf::value_type const		data_type;
+		typedef data_type*							pointer;
+		typedef data_type const*					const_pointer;
+		typedef data_type&							reference;
+		typedef data_type const&					const_reference;
+		typedef std::bidirectional_iterator_tag		iterator_category;
+		node_ptr									_leaf;
+		std::size_t									_index;
+
+	private:
+		value_type*									_value;
+		Tree*										_tree;
+		std::size_t									_version;
+
+	public:
+		bpt_bidirectional_iterator() : _leaf(0), _index(0), _value(0), _tree(0), _version(0) {}
+
+		bpt_bidirectional_iterator(node_ptr leaf, std::size_t index, Tree* tree) :	_leaf(leaf),
+																					_index(index),
+																					_value(leaf ? leaf->values[index] : 0),
+																					_tree(tree),
+																					_version(tree->_version)
+																					{}
+
+		bpt_bidirectional_iterator(const bpt_bidirectional_iterator& other) :	_leaf(other._leaf),
+																				_index(other._index),
+																				_value(other._value),
+																				_tree(other._tree),
+																				_version(other._version)
+																				{}
+		virtual ~bpt_bidirectional_iterator() {}
+
+		bpt_bidirectional_iterator& operator=(const bpt_bidirectional_iterator& other) {
+			if (this == &other) {
+				return *this;
+			}
+			this->_leaf = other._leaf;
+			this->_index = other._index;
+			this->_value = other._value;
+			this->_tree = other._tree;
+			this->_version = other._version;
+			return *this;
+		}
+
+		operator bpt_bidirectional_iterator<const node_type, const Tree>() const {
+			bpt_bidirectional_iterator<const node_type, const Tree> it;
+			it._leaf = _leaf;
+			it._index = _index;
+			it._value = _value;
+			it._tree = _tree;
+			it._version = _version;
+			return it;
+		}
+
+		reference operator*() {
+			return *_value;
+		}
+
+		const_reference operator*() const {
+			return *_value;
+		}
+
+		pointer operator->() {
+			return &(operator*());
+		}
+
+		const_pointer operator->() const {
+			return &(operator*());
+		}
+
+		bpt_bidirectional_iterator& operator++() {
+			if (_leaf) {
+				_sync();
+				++_index;
+				if (_index == _leaf->count) {
+					_leaf = _leaf->next;
+					_index = 0;
+				}
+				_value = _leaf ? _leaf->values[_index] : 0;
+			}
+			return *this;
+		}
+
+		bpt_bidirectional_iterator& operator--() {
+			_sync();
+			if (!_leaf) {
+				_leaf = _tree->_last;
+				_index = _leaf->count - 1;
+			} else if (_index == 0) {
+				_leaf = _leaf->prev;
+				_index = _leaf->count - 1;
+			} else {
+				--_index;
+			}
+			_value = _leaf->values[_index];
+			return *this;
+		}
+
+		bpt_bidirectional_iterator operator++(int) {
+			bpt_bidirectional_iterator copy = *this;
+			operator++();
+			return copy;
+		}
+
+		bpt_bidirectional_iterator operator--(int) {
+			bpt_bidirectional_iterator copy = *this;
+			operator--();
+			return copy;
+		}
+
+		// The element decides: slots of equal iterators may differ when one
+		// of them has not caught up with a change yet.
+		bool operator==(const bpt_bidirectional_iterator& other) const {
+			return _value == other._value;
+		}
+
+		bool operator!=(const bpt_bidirectional_iterator& other) const {
+			return !(*this == other);
+		}
+
+	private:
+		template<class, class> friend class bpt_bidirectional_iterator;
+
+		void _sync(void) {
+			if (_version == _tree->_version) {
+				return ;
+			}
+			if (_leaf) {
+				_leaf = _tree->_locate(*_value, _index);
+			}
+			_version = _tree->_version;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef CONCURRENT_MAP_HPP
+# define CONCURRENT_MAP_HPP
+
+#include <memory>
+#include <stdexcept>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "../utils/lock.hpp"
+#include "rb_tree.hpp"
+
+namespace ft
+{
+	// A map shared between threads. Lookups run in parallel under the
+	// shared side of a reader-writer lock. Writes are not applied by the
+	// thread that makes them: each writer queues its mutation and waits,
+	// and whichever writer finds nobody applying takes the whole queue and
+	// applies it under one exclusive lock. While that batch runs the next
+	// one collects, so under write load the exclusive lock is taken once
+	// per batch instead of once per write, and readers are held off for
+	// fewer, longer stretches.
+	//
+	// Every write returns only once it is applied, so a thread always sees
+	// its own writes, and writes apply in the order they were queued.
+	// There are no iterators: anything read out is copied under the lock.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> >,
+			class Tree = ft::red_black_tree<Key, pair<const Key, T>, select_first<pair<const Key, T> >, Compare, Allocator> >
+	class concurrent_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef Tree																	tree_type;
+		typedef std::size_t																size_type;
+
+	private:
+		enum _write_kind {_INSERT, _ASSIGN, _ERASE, _CLEAR};
+
+		// A queued mutation. It lives on the writer's stack: the writer does
+		// not return, and so does not free it, until done is set.
+		struct _write {
+			_write_kind			kind;
+			const key_type*		key;
+			const mapped_type*	obj;
+			size_type			result;
+			bool				done;
+			bool				failed;
+			_write*				next;
+
+			_write(_write_kind k, const key_type* key_ptr, const mapped_type* obj_ptr)
+				: kind(k), key(key_ptr), obj(obj_ptr), result(0), done(false), failed(false), next(0) {}
+		};
+
+		tree_type						_tree;
+		mutable ft::rw_lock				_tree_lock;
+		ft::mutex						_queue_lock;
+		ft::condition_variable			_applied;
+		_write*							_head;
+		_write*							_tail;
+		bool							_applying;
+
+	public:
+		explicit concurrent_map(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _head(0), _tail(0), _applying(false) {}
+
+		~concurrent_map() {}
+
+		// Lookups. The tree's size is kept exact by insert and erase, so
+		// these const calls never write to it and may run side by side.
+		bool find(const key_type& key, mapped_type& obj) const {
+			ft::shared_lock_guard<ft::rw_lock> guard(_tree_lock);
+			typename tree_type::const_iterator it = _tree.find(key);
+			if (it == _tree.end()) {
+				return false;
+			}
+			obj = it->second;
+			return true;
+		}
+
+		size_type count(const key_type& key) const {
+			ft::shared_lock_guard<ft::rw_lock> guard(_tree_lock);
+			return _tree.find(key) != _tree.end() ? 1 : 0;
+		}
+
+		size_type size(void) const {
+			ft::shared_lock_guard<ft::rw_lock> guard(_tree_lock);
+			return _tree.size();
+		}
+
+		bool empty(void) const {
+			ft::shared_lock_guard<ft::rw_lock> guard(_tree_lock);
+			return _tree.empty();
+		}
+
+		// Calls f on every element in key order, under the shared lock: f
+		// must not write to this map.
+		template<class Function>
+		Function for_each(Function f) const {
+			ft::shared_lock_guard<ft::rw_lock> guard(_tree_lock);
+			for (typename tree_type::const_iterator it = _tree.begin(); it != _tree.end(); ++it) {
+				f(*it);
+			}
+			return f;
+		}
+
+		// Writes. Each returns once applied. If copying the element throws
+		// in the applying thread, the write is dropped and its own thread
+		// gets std::runtime_error; the other writes of the batch go ahead.
+		bool insert(const value_type& value) {
+			_write w(_INSERT, &value.first, &value.second);
+			return _submit(w) != 0;
+		}
+
+		// True if key was new.
+		bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+			_write w(_ASSIGN, &key, &obj);
+			return _submit(w) != 0;
+		}
+
+		size_type erase(const key_type& key) {
+			_write w(_ERASE, &key, 0);
+			return _submit(w);
+		}
+
+		void clear(void) {
+			_write w(_CLEAR, 0, 0);
+			_submit(w);
+		}
+
+		key_compare key_comp(void) const {
+			return _tree.key_comp();
+		}
+
+	private:
+		size_type _submit(_write& w) {
+			_write* batch = 0;
+			{
+				ft::lock_guard<ft::mutex> guard(_queue_lock);
+				if (_tail) {
+					_tail->next = &w;
+				} else {
+					_head = &w;
+				}
+				_tail = &w;
+				while (_applying && !w.done) {
+					_applied.wait(_queue_lock);
+				}
+				if (!w.done) {
+					_applying = true;
+					batch = _head;
+					_head = 0;
+					_tail = 0;
+				}
+			}
+			if (batch) {
+				_apply(batch);
+				ft::lock_guard<ft::mutex> guard(_queue_lock);
+				while (batch) {
+					_write* next = batch->next;
+					batch->done = true;
+					batch = next;
+				}
+				_applying = false;
+				_applied.notify_all();
+			}
+			if (w.failed) {
+				throw std::runtime_error("concurrent_map: write failed");
+			}
+			return w.result;
+		}
+
+		void _apply(_write* batch) {
+			ft::lock_guard<ft::rw_lock> guard(_tree_lock);
+			for (; batch; batch = batch->next) {
+				try {
+					switch (batch->kind) {
+						case _INSERT:
+							batch->result = _tree.insert(value_type(*batch->key, *batch->obj)).second;
+							break;
+						case _ASSIGN:
+							batch->result = _tree.insert_or_assign(*batch->key, *batch->obj).second;
+							break;
+						case _ERASE:
+							batch->result = _tree.erase(*batch->key);
+							break;
+						case _CLEAR:
+							_tree.clear();
+							break;
+					}
+				} catch (...) {
+					batch->failed = true;
+				}
+			}
+		}
+
+		concurrent_map(const concurrent_map&);
+		concurrent_map& operator=(const concurrent_map&);
+	};
+}
+
+#endif
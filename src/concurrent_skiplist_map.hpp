@@ -0,0 +1,407 @@
+#ifndef CONCURRENT_SKIPLIST_MAP_HPP
+# define CONCURRENT_SKIPLIST_MAP_HPP
+
+#include <memory>
+#include <new>
+#include <iterator>
+#include <stdint.h>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "../utils/atomic.hpp"
+#include "epoch.hpp"
+
+namespace ft
+{
+	// An ordered map for many writers, with no lock anywhere: a skip list
+	// whose links are changed only by compare-and-swap (Fraser; Herlihy
+	// and Shavit). Every node has a tower of next pointers, one per level
+	// it is linked on. The lowest bit of a next pointer marks the link as
+	// deleted, so a link cannot change after its node is marked.
+	//
+	// erase() marks the tower top-down, then level 0; the thread whose
+	// mark lands on level 0 owns the erase. Any search that meets a marked
+	// link unlinks the node at that level before going on. A node leaves
+	// memory through the container's epoch_domain once both its inserter
+	// has stopped linking upper levels and its eraser has seen it unlinked,
+	// whichever comes last.
+	//
+	// Iterators see a weakly consistent list: every element present for
+	// the whole walk, maybe some added or erased during it. An iterator
+	// holds its thread inside the epoch until it is destroyed, so it must
+	// stay on its thread and should not outlive the walk. Elements are
+	// read-only; to change a value, erase and insert.
+	//
+	// Nodes are freed after the container lets go of them, through a
+	// default-constructed Allocator: the allocator must be stateless.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	class concurrent_skiplist_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef std::size_t																size_type;
+
+	private:
+		// Each level holds about a quarter of the nodes of the one below.
+		static const int			_max_levels = 24;
+
+		struct _node {
+			value_type				value;
+			int						levels;
+			// Inserter and eraser each drop one; the last one retires.
+			int						owners;
+			uintptr_t				next[1];
+
+			_node(const value_type& v, int l) : value(v), levels(l), owners(2) {}
+		};
+
+		typedef typename Allocator::template rebind<char>::other						byte_allocator;
+
+		uintptr_t					_head[_max_levels];
+		size_type					_size;
+		key_compare					_comp;
+		mutable epoch_domain		_domain;
+
+	public:
+		class const_iterator {
+		public:
+			typedef std::ptrdiff_t								difference_type;
+			typedef typename concurrent_skiplist_map::value_type	value_type;
+			typedef const value_type*							pointer;
+			typedef const value_type&							reference;
+			typedef std::forward_iterator_tag					iterator_category;
+
+			const_iterator(void) : _node_ptr(0), _domain(0) {}
+
+			const_iterator(const const_iterator& other) : _node_ptr(other._node_ptr), _domain(other._domain) {
+				if (_domain) {
+					_domain->enter();
+				}
+			}
+
+			~const_iterator(void) {
+				if (_domain) {
+					_domain->exit();
+				}
+			}
+
+			const_iterator& operator=(const const_iterator& other) {
+				if (other._domain) {
+					other._domain->enter();
+				}
+				if (_domain) {
+					_domain->exit();
+				}
+				_node_ptr = other._node_ptr;
+				_domain = other._domain;
+				return *this;
+			}
+
+			reference operator*(void) const {
+				return _node_ptr->value;
+			}
+
+			pointer operator->(void) const {
+				return &_node_ptr->value;
+			}
+
+			// Steps over nodes erased since they were reached.
+			const_iterator& operator++(void) {
+				_node* node = _unmark(atomic_load(&_node_ptr->next[0]));
+				while (node && _is_marked(atomic_load(&node->next[0]))) {
+					node = _unmark(atomic_load(&node->next[0]));
+				}
+				_node_ptr = node;
+				return *this;
+			}
+
+			const_iterator operator++(int) {
+				const_iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			bool operator==(const const_iterator& other) const {
+				return _node_ptr == other._node_ptr;
+			}
+
+			bool operator!=(const const_iterator& other) const {
+				return _node_ptr != other._node_ptr;
+			}
+
+		private:
+			friend class concurrent_skiplist_map;
+
+			_node*			_node_ptr;
+			epoch_domain*	_domain;
+
+			// Called inside a guard; the iterator keeps its own.
+			const_iterator(_node* node, epoch_domain& domain) : _node_ptr(node), _domain(node ? &domain : 0) {
+				if (_domain) {
+					_domain->enter();
+				}
+			}
+		};
+
+		typedef const_iterator															iterator;
+
+		explicit concurrent_skiplist_map(const key_compare& comp = key_compare()) : _size(0), _comp(comp) {
+			for (int level = 0; level < _max_levels; ++level) {
+				_head[level] = 0;
+			}
+		}
+
+		// No other thread may be using the map.
+		~concurrent_skiplist_map(void) {
+			_node* node = _unmark(_head[0]);
+			while (node) {
+				_node* next = _unmark(node->next[0]);
+				_free_node(node);
+				node = next;
+			}
+		}
+
+		const_iterator begin(void) const {
+			epoch_guard guard(_domain);
+			_node* node = _unmark(atomic_load(&_head[0]));
+			while (node && _is_marked(atomic_load(&node->next[0]))) {
+				node = _unmark(atomic_load(&node->next[0]));
+			}
+			return const_iterator(node, _domain);
+		}
+
+		const_iterator end(void) const {
+			return const_iterator();
+		}
+
+		// Counts inserts and erases that completed, so under concurrent
+		// writes it is a moment's approximation.
+		size_type size(void) const {
+			return atomic_load(&_size);
+		}
+
+		bool empty(void) const {
+			return size() == 0;
+		}
+
+		const_iterator find(const key_type& key) const {
+			epoch_guard guard(_domain);
+			_node* node = _lower_bound(key);
+			if (node && _comp(key, node->value.first)) {
+				node = 0;
+			}
+			return const_iterator(node, _domain);
+		}
+
+		size_type count(const key_type& key) const {
+			epoch_guard guard(_domain);
+			_node* node = _lower_bound(key);
+			return node && !_comp(key, node->value.first) ? 1 : 0;
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			epoch_guard guard(_domain);
+			return const_iterator(_lower_bound(key), _domain);
+		}
+
+		ft::pair<const_iterator, bool> insert(const value_type& value) {
+			epoch_guard guard(_domain);
+			uintptr_t* preds[_max_levels];
+			_node* succs[_max_levels];
+			_node* node = 0;
+			for (;;) {
+				if (_search(value.first, preds, succs)) {
+					if (node) {
+						_free_node(node);
+					}
+					return ft::make_pair(const_iterator(succs[0], _domain), false);
+				}
+				if (!node) {
+					node = _create_node(value, _random_level());
+				}
+				for (int level = 0; level < node->levels; ++level) {
+					node->next[level] = reinterpret_cast<uintptr_t>(succs[level]);
+				}
+				if (atomic_cas(&preds[0][0], reinterpret_cast<uintptr_t>(succs[0]), reinterpret_cast<uintptr_t>(node))) {
+					break;
+				}
+			}
+			atomic_fetch_add(&_size, 1);
+			const_iterator result(node, _domain);
+			_link_upper_levels(node, preds, succs);
+			return ft::make_pair(result, true);
+		}
+
+		size_type erase(const key_type& key) {
+			epoch_guard guard(_domain);
+			uintptr_t* preds[_max_levels];
+			_node* succs[_max_levels];
+			if (!_search(key, preds, succs)) {
+				return 0;
+			}
+			_node* node = succs[0];
+			for (int level = node->levels - 1; level > 0; --level) {
+				uintptr_t next = atomic_load(&node->next[level]);
+				while (!_is_marked(next) && !atomic_compare_exchange(&node->next[level], next, next | 1)) {}
+			}
+			uintptr_t next = atomic_load(&node->next[0]);
+			for (;;) {
+				if (_is_marked(next)) {
+					return 0;
+				}
+				if (atomic_compare_exchange(&node->next[0], next, next | 1)) {
+					break;
+				}
+			}
+			atomic_fetch_sub(&_size, 1);
+			_search(key, preds, succs);
+			_release(node);
+			return 1;
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+	private:
+		static bool _is_marked(uintptr_t link) {
+			return link & 1;
+		}
+
+		static _node* _unmark(uintptr_t link) {
+			return reinterpret_cast<_node*>(link & ~static_cast<uintptr_t>(1));
+		}
+
+		static _node* _create_node(const value_type& value, int levels) {
+			byte_allocator alloc;
+			char* bytes = alloc.allocate(sizeof(_node) + (levels - 1) * sizeof(uintptr_t));
+			try {
+				return new (bytes) _node(value, levels);
+			} catch (...) {
+				alloc.deallocate(bytes, sizeof(_node) + (levels - 1) * sizeof(uintptr_t));
+				throw;
+			}
+		}
+
+		static void _free_node(void* ptr) {
+			_node* node = static_cast<_node*>(ptr);
+			int levels = node->levels;
+			node->~_node();
+			byte_allocator().deallocate(reinterpret_cast<char*>(node), sizeof(_node) + (levels - 1) * sizeof(uintptr_t));
+		}
+
+		void _release(_node* node) {
+			if (atomic_fetch_sub(&node->owners, 1) == 1) {
+				_domain.retire(node, &_free_node);
+			}
+		}
+
+		// 1 + (trailing zero bits of a random word) / 2, from a per-thread
+		// xorshift generator.
+		static int _random_level(void) {
+			static __thread uint64_t state = 0;
+			if (!state) {
+				state = reinterpret_cast<uintptr_t>(&state) | 1;
+			}
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			int level = 1 + __builtin_ctzll(state | (static_cast<uint64_t>(1) << 62)) / 2;
+			return level < _max_levels ? level : _max_levels;
+		}
+
+		// Fills preds (the link to change) and succs (its target) on every
+		// level around key, unlinking the marked nodes met on the way.
+		// True if succs[0] holds key.
+		bool _search(const key_type& key, uintptr_t** preds, _node** succs) const {
+		retry:
+			uintptr_t* pred = const_cast<uintptr_t*>(_head);
+			for (int level = _max_levels - 1; level >= 0; --level) {
+				_node* curr = _unmark(atomic_load(&pred[level]));
+				while (curr) {
+					uintptr_t next = atomic_load(&curr->next[level]);
+					while (_is_marked(next)) {
+						if (!atomic_cas(&pred[level], reinterpret_cast<uintptr_t>(curr), next & ~static_cast<uintptr_t>(1))) {
+							goto retry;
+						}
+						curr = _unmark(next);
+						if (!curr) {
+							break;
+						}
+						next = atomic_load(&curr->next[level]);
+					}
+					if (!curr || !_comp(curr->value.first, key)) {
+						break;
+					}
+					pred = curr->next;
+					curr = _unmark(next);
+				}
+				preds[level] = pred;
+				succs[level] = curr;
+			}
+			return succs[0] && !_comp(key, succs[0]->value.first);
+		}
+
+		// First node not less than key, without unlinking anything.
+		_node* _lower_bound(const key_type& key) const {
+			const uintptr_t* pred = _head;
+			_node* curr = 0;
+			for (int level = _max_levels - 1; level >= 0; --level) {
+				curr = _unmark(atomic_load(&pred[level]));
+				while (curr) {
+					uintptr_t next = atomic_load(&curr->next[level]);
+					if (_is_marked(next)) {
+						curr = _unmark(next);
+						continue;
+					}
+					if (!_comp(curr->value.first, key)) {
+						break;
+					}
+					pred = curr->next;
+					curr = _unmark(next);
+				}
+			}
+			while (curr && _is_marked(atomic_load(&curr->next[0]))) {
+				curr = _unmark(atomic_load(&curr->next[0]));
+			}
+			return curr;
+		}
+
+		// Links node above level 0. Stops if node is erased meanwhile; the
+		// last search then clears whatever got linked.
+		void _link_upper_levels(_node* node, uintptr_t** preds, _node** succs) {
+			for (int level = 1; level < node->levels; ++level) {
+				for (;;) {
+					uintptr_t next = atomic_load(&node->next[level]);
+					if (_is_marked(next)) {
+						goto done;
+					}
+					if (next != reinterpret_cast<uintptr_t>(succs[level])
+						&& !atomic_cas(&node->next[level], next, reinterpret_cast<uintptr_t>(succs[level]))) {
+						continue;
+					}
+					if (atomic_cas(&preds[level][level], reinterpret_cast<uintptr_t>(succs[level]),
+									reinterpret_cast<uintptr_t>(node))) {
+						break;
+					}
+					if (!_search(node->value.first, preds, succs) || succs[0] != node) {
+						goto done;
+					}
+				}
+			}
+		done:
+			if (_is_marked(atomic_load(&node->next[0]))) {
+				_search(node->value.first, preds, succs);
+			}
+			_release(node);
+		}
+
+		concurrent_skiplist_map(const concurrent_skiplist_map&);
+		concurrent_skiplist_map& operator=(const concurrent_skiplist_map&);
+	};
+}
+
+#endif
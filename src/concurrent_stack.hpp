@@ -0,0 +1,436 @@
+#ifndef CONCURRENT_STACK_HPP
+# define CONCURRENT_STACK_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include "../utils/atomic.hpp"
+#include "../utils/lock.hpp"
+
+namespace ft
+{
+	// A stack for many pushing and popping threads with no lock: Treiber's
+	// stack, whose top changes only by compare-and-swap.
+	//
+	// Nodes come from a pool owned by the stack and go back to it on pop,
+	// so after warm-up a push allocates nothing. The pool grows by
+	// segments twice the size of the one before and never moves or frees
+	// a node while the stack lives, so a thread that read a node just
+	// before it was popped and reused still reads valid memory.
+	//
+	// That leaves ABA: a pop reads top A and its next B, others pop A and
+	// B and push A again, and the first pop's swap of A for B succeeds on
+	// the wrong stack. Nodes are therefore named by 32-bit pool indices,
+	// and the word holding the top carries the index beside a tag that
+	// every successful swap increments; a swap against a stale word fails
+	// unless exactly 2^32 swaps happened in between. The free list of the
+	// pool is a second stack of the same kind.
+	//
+	// Under contention every thread retries on the same top. With
+	// EliminationSlots above zero, a push or pop whose swap fails tries an
+	// elimination array instead (Hendler, Shavit and Yerushalmi): a push
+	// parks its node in a random slot for a moment, and a pop that picks
+	// that slot takes it. The pair cancels out without touching the top;
+	// it is the same as the push and the pop happening back to back.
+	//
+	// A thread that can give up LIFO order across threads can go through a
+	// buffer instead, which moves nodes to and from the stack in batches.
+	//
+	// There is no top(): another thread may pop between top() and pop().
+	// pop() copies the value out instead.
+	template<class T, std::size_t EliminationSlots = 0, class Allocator = std::allocator<T> >
+	class concurrent_stack {
+	public:
+		typedef T																		value_type;
+		typedef Allocator																allocator_type;
+		typedef std::size_t																size_type;
+
+	private:
+		struct _node {
+			// Index + 1 of the node below; 0 at the bottom.
+			uint32_t				next;
+			value_type				value;
+		};
+
+		typedef typename Allocator::template rebind<_node>::other						_node_allocator;
+
+		// A tagged word: node index + 1 in the low half, 0 for none, and
+		// the tag in the high half. Each on its own cache line.
+		struct _slot {
+			uint64_t				word;
+			char					pad[cache_line_size - sizeof(uint64_t)];
+		};
+
+		// Segment s holds 64 << s nodes; 26 segments hold 2^32 - 64.
+		static const int			_first_shift = 6;
+		static const int			_max_segments = 26;
+		static const uint32_t		_none = 0xffffffffu;
+		static const size_type		_slot_count = EliminationSlots ? EliminationSlots : 1;
+		// How long a push waits in a slot for a pop.
+		static const int			_elimination_spins = 128;
+
+		_slot						_top;
+		_slot						_free;
+		_slot						_slots[_slot_count];
+		size_type					_fresh;
+		_node*						_segments[_max_segments];
+		allocator_type				_alloc;
+		_node_allocator				_node_alloc;
+
+	public:
+		// A thread's private end of the stack. Pushes collect in the buffer
+		// and reach the stack a batch at a time, with one swap; a pop takes
+		// the buffer's newest element, or else takes a batch off the stack
+		// with one swap. Freed nodes are kept and returned the same way.
+		//
+		// Other threads see an element only once its batch is flushed, and
+		// a thread pops its own recent pushes first, so across threads the
+		// order is no longer LIFO: this is a pool with stack locality. The
+		// destructor flushes; it must run before the stack's.
+		class buffer {
+		public:
+			explicit buffer(concurrent_stack& stack, size_type batch = 32)
+				: _stack(&stack), _batch(batch ? batch : 1), _items(0), _items_last(0), _item_count(0),
+				_spare(0), _spare_last(0), _spare_count(0) {}
+
+			~buffer(void) {
+				flush();
+				_stack->_push_chain(&_stack->_free, _spare, _spare_last);
+			}
+
+			void push(const value_type& value) {
+				uint32_t index = _take_spare();
+				_node* node = _stack->_node_at(index);
+				try {
+					_stack->_alloc.construct(&node->value, value);
+				} catch (...) {
+					_link(_spare, _spare_last, _spare_count, index);
+					throw;
+				}
+				_link(_items, _items_last, _item_count, index);
+				if (_item_count >= _batch) {
+					flush();
+				}
+			}
+
+			bool pop(value_type& value) {
+				if (!_items) {
+					_item_count = _stack->_pop_chain(&_stack->_top, _batch, _items, _items_last);
+					if (!_items) {
+						return false;
+					}
+				}
+				uint32_t index = _unlink(_items, _item_count);
+				_node* node = _stack->_node_at(index);
+				try {
+					value = node->value;
+				} catch (...) {
+					_link(_items, _items_last, _item_count, index);
+					throw;
+				}
+				_stack->_alloc.destroy(&node->value);
+				_link(_spare, _spare_last, _spare_count, index);
+				if (_spare_count >= 2 * _batch) {
+					_stack->_push_chain(&_stack->_free, _spare, _spare_last);
+					_spare = 0;
+					_spare_count = 0;
+				}
+				return true;
+			}
+
+			// Makes every element pushed through this buffer visible.
+			void flush(void) {
+				_stack->_push_chain(&_stack->_top, _items, _items_last);
+				_items = 0;
+				_item_count = 0;
+			}
+
+		private:
+			concurrent_stack*	_stack;
+			size_type			_batch;
+			// Local chains, linked like the stack: first is the newest.
+			uint32_t			_items;
+			uint32_t			_items_last;
+			size_type			_item_count;
+			uint32_t			_spare;
+			uint32_t			_spare_last;
+			size_type			_spare_count;
+
+			uint32_t _take_spare(void) {
+				if (!_spare) {
+					_spare_count = _stack->_pop_chain(&_stack->_free, _batch, _spare, _spare_last);
+					if (!_spare) {
+						return _stack->_fresh_index();
+					}
+				}
+				return _unlink(_spare, _spare_count);
+			}
+
+			void _link(uint32_t& first, uint32_t& last, size_type& count, uint32_t index) {
+				atomic_store_relaxed(&_stack->_node_at(index)->next, first);
+				if (!first) {
+					last = index + 1;
+				}
+				first = index + 1;
+				++count;
+			}
+
+			uint32_t _unlink(uint32_t& first, size_type& count) {
+				uint32_t index = first - 1;
+				first = atomic_load_relaxed(&_stack->_node_at(index)->next);
+				--count;
+				return index;
+			}
+
+			buffer(const buffer&);
+			buffer& operator=(const buffer&);
+		};
+
+		explicit concurrent_stack(const allocator_type& alloc = allocator_type())
+			: _fresh(0), _alloc(alloc), _node_alloc(alloc) {
+			_top.word = 0;
+			_free.word = 0;
+			for (size_type i = 0; i < _slot_count; ++i) {
+				_slots[i].word = 0;
+			}
+			for (int s = 0; s < _max_segments; ++s) {
+				_segments[s] = 0;
+			}
+		}
+
+		// No other thread may still use the stack, and no buffer be left.
+		~concurrent_stack(void) {
+			for (uint32_t link = static_cast<uint32_t>(_top.word); link; link = _node_at(link - 1)->next) {
+				_alloc.destroy(&_node_at(link - 1)->value);
+			}
+			for (int s = 0; s < _max_segments && _segments[s]; ++s) {
+				_node_alloc.deallocate(_segments[s], _segment_size(s));
+			}
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		// A snapshot: other threads may push or pop right after.
+		bool empty(void) const {
+			return static_cast<uint32_t>(atomic_load(&_top.word)) == 0;
+		}
+
+		// Allocates the pool up front for n elements in the stack at once.
+		void reserve(size_type n) {
+			for (int s = 0; s < _max_segments && n > _first_index(s); ++s) {
+				_ensure_segment(s);
+			}
+		}
+
+		void push(const value_type& value) {
+			uint32_t index = _acquire();
+			_node* node = _node_at(index);
+			try {
+				_alloc.construct(&node->value, value);
+			} catch (...) {
+				_push(&_free, index);
+				throw;
+			}
+			uint64_t old = atomic_load_relaxed(&_top.word);
+			while (!_try_push(&_top.word, index, old)) {
+				if (EliminationSlots && _eliminate_push(index)) {
+					return;
+				}
+			}
+		}
+
+		// False if the stack was empty. If copying the value out throws,
+		// the element goes back on top of the stack.
+		bool pop(value_type& value) {
+			uint32_t index;
+			uint64_t old = atomic_load(&_top.word);
+			while (!_try_pop(&_top.word, old, index)) {
+				if (EliminationSlots && (index = _eliminate_pop()) != _none) {
+					break;
+				}
+			}
+			if (index == _none) {
+				return false;
+			}
+			_node* node = _node_at(index);
+			try {
+				value = node->value;
+			} catch (...) {
+				_push(&_top, index);
+				throw;
+			}
+			_alloc.destroy(&node->value);
+			_push(&_free, index);
+			return true;
+		}
+
+	private:
+		static size_type _segment_size(int s) {
+			return static_cast<size_type>(1) << (s + _first_shift);
+		}
+
+		static size_type _first_index(int s) {
+			return _segment_size(s) - _segment_size(0);
+		}
+
+		static uint64_t _tagged(uint64_t old, uint32_t link) {
+			return ((old >> 32) + 1) << 32 | link;
+		}
+
+		// xorshift generator.
+		static uint64_t _random(void) {
+			static __thread uint64_t state = 0;
+			if (!state) {
+				state = reinterpret_cast<uintptr_t>(&state) | 1;
+			}
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+
+		_node* _node_at(uint32_t index) const {
+			uint64_t position = static_cast<uint64_t>(index) + _segment_size(0);
+			int s = 63 - __builtin_clzll(position) - _first_shift;
+			return atomic_load(&_segments[s]) + (position - _segment_size(s));
+		}
+
+		// Threads that find a segment missing race to install one; the
+		// losers free theirs.
+		void _ensure_segment(int s) {
+			if (atomic_load(&_segments[s])) {
+				return;
+			}
+			_node* segment = _node_alloc.allocate(_segment_size(s));
+			_node* expected = 0;
+			if (!atomic_compare_exchange(&_segments[s], expected, segment)) {
+				_node_alloc.deallocate(segment, _segment_size(s));
+			}
+		}
+
+		// A free node: a recycled one, or else one never used.
+		uint32_t _acquire(void) {
+			uint32_t index = _pop(&_free);
+			return index != _none ? index : _fresh_index();
+		}
+
+		uint32_t _fresh_index(void) {
+			size_type fresh = atomic_fetch_add(&_fresh, 1);
+			if (fresh >= _first_index(_max_segments)) {
+				atomic_fetch_sub(&_fresh, 1);
+				throw std::length_error("concurrent_stack");
+			}
+			int s = 63 - __builtin_clzll(fresh + _segment_size(0)) - _first_shift;
+			_ensure_segment(s);
+			return static_cast<uint32_t>(fresh);
+		}
+
+		// One attempt; on failure old holds the word found.
+		bool _try_push(uint64_t* head, uint32_t index, uint64_t& old) {
+			atomic_store_relaxed(&_node_at(index)->next, static_cast<uint32_t>(old));
+			return atomic_compare_exchange(head, old, _tagged(old, index + 1));
+		}
+
+		// One attempt; index is _none if the stack was empty. next may be
+		// read from a node another thread has just taken; the tag then
+		// fails the swap.
+		bool _try_pop(uint64_t* head, uint64_t& old, uint32_t& index) {
+			uint32_t link = static_cast<uint32_t>(old);
+			if (!link) {
+				index = _none;
+				return true;
+			}
+			uint32_t next = atomic_load_relaxed(&_node_at(link - 1)->next);
+			index = link - 1;
+			return atomic_compare_exchange(head, old, _tagged(old, next));
+		}
+
+		void _push(_slot* head, uint32_t index) {
+			uint64_t old = atomic_load_relaxed(&head->word);
+			while (!_try_push(&head->word, index, old)) {}
+		}
+
+		uint32_t _pop(_slot* head) {
+			uint32_t index;
+			uint64_t old = atomic_load(&head->word);
+			while (!_try_pop(&head->word, old, index)) {}
+			return index;
+		}
+
+		// Pushes a chain already linked from first (index + 1) down to last
+		// with one swap.
+		void _push_chain(_slot* head, uint32_t first, uint32_t last) {
+			if (!first) {
+				return;
+			}
+			_node* bottom = _node_at(last - 1);
+			uint64_t old = atomic_load_relaxed(&head->word);
+			do {
+				atomic_store_relaxed(&bottom->next, static_cast<uint32_t>(old));
+			} while (!atomic_compare_exchange(&head->word, old, _tagged(old, first)));
+		}
+
+		// Takes up to max nodes off the top with one swap. If the tag did
+		// not change, nothing was pushed or popped meanwhile, so the links
+		// walked were the stack's. Returns how many; first is 0 if none.
+		size_type _pop_chain(_slot* head, size_type max, uint32_t& first, uint32_t& last) {
+			uint64_t old = atomic_load(&head->word);
+			for (;;) {
+				first = static_cast<uint32_t>(old);
+				if (!first) {
+					return 0;
+				}
+				size_type count = 1;
+				last = first;
+				uint32_t next = atomic_load_relaxed(&_node_at(last - 1)->next);
+				for (; next && count < max; ++count) {
+					last = next;
+					next = atomic_load_relaxed(&_node_at(last - 1)->next);
+				}
+				if (atomic_compare_exchange(&head->word, old, _tagged(old, next))) {
+					atomic_store_relaxed(&_node_at(last - 1)->next, static_cast<uint32_t>(0));
+					return count;
+				}
+			}
+		}
+
+		// A push parks its node in a free slot and waits. If a pop clears
+		// the slot the push is done; otherwise it takes the node back,
+		// unless a pop wins that race too.
+		bool _eliminate_push(uint32_t index) {
+			_slot& slot = _slots[_random() % _slot_count];
+			uint64_t empty = atomic_load(&slot.word);
+			if (static_cast<uint32_t>(empty)) {
+				return false;
+			}
+			uint64_t parked = _tagged(empty, index + 1);
+			if (!atomic_cas(&slot.word, empty, parked)) {
+				return false;
+			}
+			for (int spin = 0; spin < _elimination_spins; ++spin) {
+				if (atomic_load(&slot.word) != parked) {
+					return true;
+				}
+				cpu_relax();
+			}
+			return !atomic_cas(&slot.word, parked, _tagged(parked, 0));
+		}
+
+		uint32_t _eliminate_pop(void) {
+			_slot& slot = _slots[_random() % _slot_count];
+			uint64_t parked = atomic_load(&slot.word);
+			uint32_t link = static_cast<uint32_t>(parked);
+			if (!link || !atomic_cas(&slot.word, parked, _tagged(parked, 0))) {
+				return _none;
+			}
+			return link - 1;
+		}
+
+		concurrent_stack(const concurrent_stack&);
+		concurrent_stack& operator=(const concurrent_stack&);
+	};
+}
+
+#endif
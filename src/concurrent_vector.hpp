@@ -0,0 +1,298 @@
+#ifndef CONCURRENT_VECTOR_HPP
+# define CONCURRENT_VECTOR_HPP
+
+# include "../utils/atomic.hpp"
+# include "../utils/reverse_iterator.hpp"
+# include "../utils/type_traits.hpp"
+# include "cv_random_access_iterator.hpp"
+# include <memory>
+# include <stdexcept>
+
+namespace ft
+{
+	// A vector that many threads append to while others read it. Elements
+	// live in segments, each twice the size of the one before, that are
+	// never reallocated: an element does not move once constructed, and a
+	// reference or iterator to it stays valid while the vector lives.
+	//
+	// push_back installs the segment for the next index if nobody has yet
+	// (racing threads free the losers), then claims the index with a
+	// compare-and-swap and constructs the element in place. A failed swap
+	// means another push got the index first, and no thread waits for
+	// another. The segment comes first so that a bad_alloc leaves no
+	// index claimed that would never be built.
+	// As elements may finish out of order, each has a ready flag, and
+	// size() is the length of the prefix that is all ready: every pusher
+	// moves it over the ready elements it finds after its own.
+	//
+	// operator[] is wait-free: a load of the segment pointer and an
+	// offset. Any index below a size() the thread has read is safe.
+	// Elements are never erased; clear() and the destructor need the
+	// vector to themselves.
+	//
+	// Copying a T must not throw, which is checked at compile time: an
+	// index is taken before its element is built, and a copy that failed
+	// would leave a slot with no element that size() could never pass.
+	template<class T, class Allocator = std::allocator<T> >
+	class concurrent_vector {
+	public:
+		typedef T																		value_type;
+		typedef Allocator																allocator_type;
+
+		typedef typename allocator_type::reference										reference;
+		typedef typename allocator_type::const_reference								const_reference;
+		typedef typename allocator_type::size_type										size_type;
+		typedef typename allocator_type::difference_type								difference_type;
+		typedef typename allocator_type::pointer										pointer;
+		typedef typename allocator_type::const_pointer									const_pointer;
+
+		typedef ft::cv_random_access_iterator<value_type, concurrent_vector>				iterator;
+		typedef ft::cv_random_access_iterator<const value_type, const concurrent_vector>	const_iterator;
+		typedef ft::reverse_iterator<iterator>											reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>									const_reverse_iterator;
+
+	private:
+		typedef typename Allocator::template rebind<char>::other						_byte_allocator;
+
+		// Does not compile for a T whose copy may throw.
+		typedef char _nothrow_copy_required[ft::is_nothrow_copy_constructible<T>::value ? 1 : -1];
+
+		// Segment s holds 64 << s elements, then one ready flag for each.
+		static const int			_first_shift = 6;
+		static const int			_max_segments = sizeof(size_type) * 8 - _first_shift;
+
+		pointer						_segments[_max_segments];
+		size_type					_reserved;
+		size_type					_size;
+		allocator_type				_alloc;
+		_byte_allocator				_byte_alloc;
+
+	public:
+		explicit concurrent_vector(const allocator_type& alloc = allocator_type())
+			: _reserved(0), _size(0), _alloc(alloc), _byte_alloc(alloc) {
+			for (int s = 0; s < _max_segments; ++s) {
+				_segments[s] = 0;
+			}
+		}
+
+		~concurrent_vector(void) {
+			clear();
+			for (int s = 0; s < _max_segments && _segments[s]; ++s) {
+				_byte_alloc.deallocate(reinterpret_cast<char*>(_segments[s]), _segment_bytes(s));
+			}
+		}
+
+		allocator_type get_allocator(void) const {
+			return this->_alloc;
+		}
+
+		// Where the new element lives.
+		iterator push_back(const value_type& value) {
+			size_type index = atomic_load(&_reserved);
+			do {
+				_ensure_segment(_segment_of(index));
+			} while (!atomic_compare_exchange(&_reserved, index, index + 1));
+			int s = _segment_of(index);
+			pointer segment = atomic_load(&_segments[s]);
+			size_type offset = index - _first_index(s);
+			_alloc.construct(segment + offset, value);
+			_publish(index, s, offset);
+			return iterator(this, index);
+		}
+
+		reference at(size_type pos) {
+			if (pos >= size()) {
+				throw std::out_of_range("Out of range");
+			}
+			return (*this)[pos];
+		}
+
+		const_reference at(size_type pos) const {
+			if (pos >= size()) {
+				throw std::out_of_range("Out of range");
+			}
+			return (*this)[pos];
+		}
+
+		reference operator[](size_type pos) {
+			int s = _segment_of(pos);
+			return atomic_load(&_segments[s])[pos - _first_index(s)];
+		}
+
+		const_reference operator[](size_type pos) const {
+			int s = _segment_of(pos);
+			return atomic_load(&_segments[s])[pos - _first_index(s)];
+		}
+
+		reference front(void) {
+			return (*this)[0];
+		}
+
+		const_reference front(void) const {
+			return (*this)[0];
+		}
+
+		// The last element of size() as read now.
+		reference back(void) {
+			return (*this)[size() - 1];
+		}
+
+		const_reference back(void) const {
+			return (*this)[size() - 1];
+		}
+
+		// end() is taken at the time of the call: a walk sees the elements
+		// ready then, and none appended after.
+		iterator begin(void) {
+			return iterator(this, 0);
+		}
+
+		const_iterator begin(void) const {
+			return const_iterator(this, 0);
+		}
+
+		iterator end(void) {
+			return iterator(this, size());
+		}
+
+		const_iterator end(void) const {
+			return const_iterator(this, size());
+		}
+
+		reverse_iterator rbegin(void) {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend(void) {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend(void) const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool empty() const {
+			return size() == 0;
+		}
+
+		size_type size(void) const {
+			return atomic_load(&_size);
+		}
+
+		size_type max_size() const {
+			return _first_index(_max_segments - 1) + _segment_size(_max_segments - 1);
+		}
+
+		// Installs the segments for n elements, so push_back allocates
+		// nothing until the vector outgrows them.
+		void reserve(size_type n) {
+			for (int s = 0; s < _max_segments && n > _first_index(s); ++s) {
+				_ensure_segment(s);
+			}
+		}
+
+		size_type capacity(void) const {
+			int s = 0;
+			while (s < _max_segments && atomic_load(&_segments[s])) {
+				++s;
+			}
+			return _first_index(s);
+		}
+
+		// Not safe while other threads use the vector. Keeps the segments.
+		void clear(void) {
+			for (size_type i = 0; i < _reserved; ++i) {
+				int s = _segment_of(i);
+				_alloc.destroy(_segments[s] + (i - _first_index(s)));
+				_ready_flags(s)[i - _first_index(s)] = 0;
+			}
+			_reserved = 0;
+			_size = 0;
+		}
+
+	private:
+		static size_type _segment_size(int s) {
+			return static_cast<size_type>(1) << (s + _first_shift);
+		}
+
+		static size_type _first_index(int s) {
+			return _segment_size(s) - _segment_size(0);
+		}
+
+		static size_type _segment_bytes(int s) {
+			return _segment_size(s) * (sizeof(value_type) + 1);
+		}
+
+		static int _segment_of(size_type index) {
+			return static_cast<int>(sizeof(unsigned long long) * 8) - 1
+				- __builtin_clzll(index + _segment_size(0)) - _first_shift;
+		}
+
+		unsigned char* _ready_flags(int s) const {
+			return reinterpret_cast<unsigned char*>(atomic_load(&_segments[s]) + _segment_size(s));
+		}
+
+		// Threads that find a segment missing race to install one; the
+		// losers free theirs.
+		void _ensure_segment(int s) {
+			if (atomic_load(&_segments[s])) {
+				return;
+			}
+			char* bytes = _byte_alloc.allocate(_segment_bytes(s));
+			pointer segment = reinterpret_cast<pointer>(bytes);
+			unsigned char* flags = reinterpret_cast<unsigned char*>(segment + _segment_size(s));
+			for (size_type i = 0; i < _segment_size(s); ++i) {
+				flags[i] = 0;
+			}
+			pointer expected = 0;
+			if (!atomic_compare_exchange(&_segments[s], expected, segment)) {
+				_byte_alloc.deallocate(bytes, _segment_bytes(s));
+			}
+		}
+
+		bool _is_ready(size_type index) const {
+			int s = _segment_of(index);
+			return atomic_load(&_segments[s]) && atomic_load_seq_cst(&_ready_flags(s)[index - _first_index(s)]);
+		}
+
+		// Makes the element at index part of size(), then moves size() over
+		// the run of ready elements after it, with one swap per run. When
+		// size() is still short of index, the element is marked ready for
+		// whoever brings size() up to it. The flag store and the reads
+		// around it are sequentially consistent: a pusher that stops at an
+		// element not yet ready ran before that element's pusher took
+		// size() past it, which then sees the flag, so no ready element is
+		// left out of size().
+		void _publish(size_type index, int s, size_type offset) {
+			size_type size = index;
+			if (atomic_compare_exchange(&_size, size, index + 1)) {
+				size = index + 1;
+			} else {
+				atomic_store_fence(&_ready_flags(s)[offset], static_cast<unsigned char>(1));
+				size = atomic_load_seq_cst(&_size);
+			}
+			for (;;) {
+				size_type end = size;
+				size_type reserved = atomic_load(&_reserved);
+				while (end < reserved && _is_ready(end)) {
+					++end;
+				}
+				if (end == size) {
+					return;
+				}
+				if (atomic_compare_exchange(&_size, size, end)) {
+					size = end;
+				}
+			}
+		}
+
+		concurrent_vector(const concurrent_vector&);
+		concurrent_vector& operator=(const concurrent_vector&);
+	};
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef CV_RANDOM_ACCESS_ITERATOR_HPP
+# define CV_RANDOM_ACCESS_ITERATOR_HPP
+
+# include <cstddef> // ptrdiff_t
+# include <iterator> //std::random_access_iterator_tag
+
+namespace ft
+{
+	// Iterator of a concurrent_vector. Its elements are spread over
+	// segments, so it holds the container and an index, and goes through
+	// the container's operator[] to reach an element.
+	template<class T, class Container>
+	class cv_random_access_iterator {
+	public:
+		typedef std::ptrdiff_t						difference_type;
+		typedef T									value_type;
+		typedef value_type*							pointer;
+		typedef const value_type*					const_pointer;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef std::random_access_iterator_tag		iterator_category;
+
+	private:
+		Container*									_container;
+		difference_type								_index;
+
+	public:
+		cv_random_access_iterator() : _container(0), _index(0) {}
+
+		explicit cv_random_access_iterator(Container* container, difference_type index = 0) :	_container(container),
+																								_index(index)
+																								{}
+
+		cv_random_access_iterator(const cv_random_access_iterator& other) :	_container(other._container),
+																			_index(other._index)
+																			{}
+		virtual ~cv_random_access_iterator() {}
+
+		cv_random_access_iterator& operator=(const cv_random_access_iterator& other) {
+			if (this == &other) {
+				return *this;
+			}
+			this->_container = other._container;
+			this->_index = other._index;
+			return *this;
+		}
+
+		operator cv_random_access_iterator<const value_type, const Container>() const {
+			return cv_random_access_iterator<const value_type, const Container>(_container, _index);
+		}
+
+		reference operator*() const {
+			return (*_container)[_index];
+		}
+
+		pointer operator->() const {
+			return &(*_container)[_index];
+		}
+
+		reference operator[](difference_type n) const {
+			return (*_container)[_index + n];
+		}
+
+		difference_type index(void) const {
+			return _index;
+		}
+
+		cv_random_access_iterator& operator++() {
+			++_index;
+			return *this;
+		}
+
+		cv_random_access_iterator& operator--() {
+			--_index;
+			return *this;
+		}
+
+		cv_random_access_iterator operator++(int) {
+			cv_random_access_iterator copy = *this;
+			++_index;
+			return copy;
+		}
+
+		cv_random_access_iterator operator--(int) {
+			cv_random_access_iterator copy = *this;
+			--_index;
+			return copy;
+		}
+
+		cv_random_access_iterator& operator+=(difference_type n) {
+			_index += n;
+			return *this;
+		}
+
+		cv_random_access_iterator& operator-=(difference_type n) {
+			_index -= n;
+			return *this;
+		}
+
+		cv_random_access_iterator operator+(difference_type n) const {
+			return cv_random_access_iterator(_container, _index + n);
+		}
+
+		cv_random_access_iterator operator-(difference_type n) const {
+			return cv_random_access_iterator(_container, _index - n);
+		}
+
+		difference_type operator-(const cv_random_access_iterator& other) const {
+			return _index - other._index;
+		}
+
+		bool operator==(const cv_random_access_iterator& other) const {
+			return _index == other._index;
+		}
+
+		bool operator!=(const cv_random_access_iterator& other) const {
+			return _index != other._index;
+		}
+
+		bool operator<(const cv_random_access_iterator& other) const {
+			return _index < other._index;
+		}
+
+		bool operator<=(const cv_random_access_iterator& other) const {
+			return _index <= other._index;
+		}
+
+		bool operator>(const cv_random_access_iterator& other) const {
+			return _index > other._index;
+		}
+
+		bool operator>=(const cv_random_access_iterator& other) const {
+			return _index >= other._index;
+		}
+	};
+
+	template<class T, class Container>
+	cv_random_access_iterator<T, Container> operator+(typename cv_random_access_iterator<T, Container>::difference_type n,
+													const cv_random_access_iterator<T, Container>& other) {
+		return other + n;
+	}
+}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef EPOCH_HPP
+# define EPOCH_HPP
+
+# include <cstddef>
+# include <pthread.h>
+# include <sched.h>
+# include "../utils/atomic.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	// Epoch-based reclamation for the lock-free containers. A thread reads
+	// shared nodes only inside an epoch_guard. A node taken out of the
+	// structure is not freed but retired, tagged with the global epoch of
+	// the moment. The global epoch moves on only when every thread inside
+	// a guard has seen the current one, so once it has moved twice past a
+	// node's tag, no thread can still hold the node and it is freed.
+	//
+	// Each container owns its domain, so destroying the container frees
+	// everything it retired. A thread keeps one record per domain, found
+	// by thread id on first use and cached for the domain it used last.
+	// Records of threads that exit stay, inactive, until the domain goes.
+	//
+	// A thread that stays inside a guard holds the epoch back: nothing
+	// retired from then on is freed until it leaves.
+	class epoch_domain {
+	public:
+		typedef void (*deleter_type)(void*);
+
+		epoch_domain(void) : _epoch(0), _records(0), _id(_next_id()) {}
+
+		~epoch_domain(void) {
+			_record* rec = _records;
+			while (rec) {
+				_record* next = rec->next;
+				for (std::size_t i = 0; i < 3; ++i) {
+					_free_bag(rec->bags[i]);
+				}
+				delete rec;
+				rec = next;
+			}
+		}
+
+		void enter(void) {
+			_record* rec = _self();
+			if (rec->depth++ == 0) {
+				// The fence orders the announcement before every read of
+				// the structure that follows.
+				atomic_store_fence(&rec->state, (atomic_load(&_epoch) << 1) | 1);
+			}
+		}
+
+		void exit(void) {
+			_record* rec = _self();
+			if (--rec->depth == 0) {
+				atomic_store(&rec->state, static_cast<std::size_t>(0));
+			}
+		}
+
+		// ptr must already be unreachable for threads that enter from now
+		// on. deleter runs once no thread can still be reading it.
+		void retire(void* ptr, deleter_type deleter) {
+			_record* rec = _self();
+			std::size_t epoch = atomic_load(&_epoch);
+			std::size_t bag = epoch % 3;
+			if (rec->bag_epochs[bag] != epoch) {
+				// Tagged three epochs ago or earlier: safe.
+				_free_bag(rec->bags[bag]);
+				rec->bag_epochs[bag] = epoch;
+			}
+			rec->bags[bag].push_back(_retired(ptr, deleter));
+			if (++rec->retired_since_scan >= _scan_threshold) {
+				rec->retired_since_scan = 0;
+				_try_advance();
+				_collect(rec);
+			}
+		}
+
+		// Waits until every thread inside a guard when it was called has
+		// left it, then frees what this thread retired. Must not be called
+		// inside a guard.
+		void synchronize(void) {
+			std::size_t target = atomic_load(&_epoch) + 2;
+			while (atomic_load(&_epoch) < target) {
+				if (!_try_advance()) {
+					sched_yield();
+				}
+			}
+			_collect(_self());
+		}
+
+	private:
+		struct _retired {
+			void*			ptr;
+			deleter_type	deleter;
+
+			_retired(void) : ptr(0), deleter(0) {}
+			_retired(void* p, deleter_type d) : ptr(p), deleter(d) {}
+		};
+
+		struct _record {
+			// Epoch seen on entry shifted left, active bit lowest; 0 outside.
+			std::size_t				state;
+			std::size_t				depth;
+			pthread_t				owner;
+			ft::vector<_retired>	bags[3];
+			std::size_t				bag_epochs[3];
+			std::size_t				retired_since_scan;
+			_record*				next;
+
+			explicit _record(pthread_t self) : state(0), depth(0), owner(self), retired_since_scan(0), next(0) {
+				bag_epochs[0] = bag_epochs[1] = bag_epochs[2] = 0;
+			}
+		};
+
+		struct _cache {
+			std::size_t		id;
+			_record*		rec;
+		};
+
+		// Retires between attempts to move the epoch on.
+		static const std::size_t	_scan_threshold = 64;
+
+		std::size_t		_epoch;
+		_record*		_records;
+		std::size_t		_id;
+
+		static std::size_t _next_id(void) {
+			static std::size_t last = 0;
+			return atomic_fetch_add(&last, 1) + 1;
+		}
+
+		static _cache& _thread_cache(void) {
+			static __thread _cache cache = {0, 0};
+			return cache;
+		}
+
+		_record* _self(void) {
+			_cache& cache = _thread_cache();
+			if (cache.id == _id) {
+				return cache.rec;
+			}
+			pthread_t self = pthread_self();
+			_record* rec = atomic_load(&_records);
+			while (rec && !pthread_equal(rec->owner, self)) {
+				rec = rec->next;
+			}
+			if (!rec) {
+				rec = new _record(self);
+				rec->next = atomic_load(&_records);
+				while (!atomic_compare_exchange(&_records, rec->next, rec)) {}
+			}
+			cache.id = _id;
+			cache.rec = rec;
+			return rec;
+		}
+
+		bool _try_advance(void) {
+			std::size_t epoch = atomic_load(&_epoch);
+			for (_record* rec = atomic_load(&_records); rec; rec = rec->next) {
+				std::size_t state = atomic_load(&rec->state);
+				if ((state & 1) && (state >> 1) != epoch) {
+					return false;
+				}
+			}
+			atomic_cas(&_epoch, epoch, epoch + 1);
+			return true;
+		}
+
+		void _collect(_record* rec) {
+			std::size_t epoch = atomic_load(&_epoch);
+			for (std::size_t i = 0; i < 3; ++i) {
+				if (rec->bag_epochs[i] + 2 <= epoch) {
+					_free_bag(rec->bags[i]);
+				}
+			}
+		}
+
+		static void _free_bag(ft::vector<_retired>& bag) {
+			for (std::size_t i = 0; i < bag.size(); ++i) {
+				bag[i].deleter(bag[i].ptr);
+			}
+			bag.clear();
+		}
+
+		epoch_domain(const epoch_domain&);
+		epoch_domain& operator=(const epoch_domain&);
+	};
+
+	class epoch_guard {
+	public:
+		explicit epoch_guard(epoch_domain& domain) : _domain(domain) {
+			_domain.enter();
+		}
+
+		~epoch_guard(void) {
+			_domain.exit();
+		}
+
+	private:
+		epoch_domain&	_domain;
+
+		epoch_guard(const epoch_guard&);
+		epoch_guard& operator=(const epoch_guard&);
+	};
+}
+
+#endif
@@ -0,0 +1,435 @@
+#ifndef HASH_TABLE_HPP
+# define HASH_TABLE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include <stdexcept>
+# include "../utils/pair.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/hash.hpp"
+# include "../utils/type_traits.hpp"
+# include "ht_forward_iterator.hpp"
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+namespace ft
+{
+	// Control byte values. A full slot stores the low 7 bits of its hash,
+	// so every full slot has a non-negative control byte.
+	enum ht_ctrl {HT_EMPTY = -128, HT_DELETED = -2, HT_SENTINEL = -1};
+
+	// Sixteen consecutive control bytes, compared all at once. Each match
+	// returns a bitmask with bit i set when byte i matches.
+	struct ht_group {
+		static const std::size_t width = 16;
+
+# if defined(__SSE2__)
+		__m128i ctrl;
+
+		explicit ht_group(const signed char* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+		unsigned match(signed char tag) const {
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl));
+		}
+
+		unsigned match_empty(void) const {
+			return match(static_cast<signed char>(HT_EMPTY));
+		}
+
+		unsigned match_empty_or_deleted(void) const {
+			return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(static_cast<signed char>(HT_SENTINEL)), ctrl));
+		}
+# else
+		const signed char* ctrl;
+
+		explicit ht_group(const signed char* pos) : ctrl(pos) {}
+
+		unsigned match(signed char tag) const {
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < width; ++i) {
+				if (ctrl[i] == tag) {
+					mask |= 1u << i;
+				}
+			}
+			return mask;
+		}
+
+		unsigned match_empty(void) const {
+			return match(static_cast<signed char>(HT_EMPTY));
+		}
+
+		unsigned match_empty_or_deleted(void) const {
+			unsigned mask = 0;
+			for (std::size_t i = 0; i < width; ++i) {
+				if (ctrl[i] < HT_SENTINEL) {
+					mask |= 1u << i;
+				}
+			}
+			return mask;
+		}
+# endif
+
+		static std::size_t lowest_bit(unsigned mask) {
+# if defined(__GNUC__)
+			return __builtin_ctz(mask);
+# else
+			std::size_t i = 0;
+			while (!(mask & 1u)) {
+				mask >>= 1;
+				++i;
+			}
+			return i;
+# endif
+		}
+	};
+
+	// Open-addressing table in the SwissTable layout: a flat slot array and a
+	// parallel array of one control byte per slot. The hash is split into a
+	// probe start (high bits) and a 7-bit tag (low bits); a lookup scans one
+	// group of 16 control bytes per step and only touches slots whose tag
+	// matches. The first group is mirrored past the end of the control array
+	// so a group load never has to wrap. Capacity is a power of two, at
+	// least one group wide, and kept at most 7/8 full.
+	template<class Key, class Value, class KeyOfValue, class Hash = ft::hash<Key>,
+			class KeyEqual = ft::equal_to<Key>, class Allocator = std::allocator<Value> >
+	class hash_table {
+	public:
+		typedef Key														key_type;
+		typedef Value													value_type;
+		typedef Hash													hasher;
+		typedef KeyEqual												key_equal;
+		typedef Allocator												allocator_type;
+		typedef std::size_t												size_type;
+		typedef std::ptrdiff_t											difference_type;
+		typedef ft::ht_forward_iterator<value_type>						iterator;
+		typedef ft::ht_forward_iterator<const value_type>				const_iterator;
+
+	private:
+		typedef typename Allocator::template rebind<signed char>::other	ctrl_allocator;
+
+		signed char*	_ctrl;
+		value_type*		_slots;
+		size_type		_capacity;
+		size_type		_size;
+		size_type		_growth_left;
+		hasher			_hash;
+		key_equal		_eq;
+		allocator_type	_alloc;
+		ctrl_allocator	_ctrl_alloc;
+		KeyOfValue		_key_of;
+
+	public:
+		explicit hash_table(size_type bucket_count = 0, const hasher& hash = hasher(),
+							const key_equal& equal = key_equal(),
+							const allocator_type& alloc = allocator_type()) :	_ctrl(0), _slots(0), _capacity(0),
+																				_size(0), _growth_left(0), _hash(hash),
+																				_eq(equal), _alloc(alloc),
+																				_ctrl_alloc(alloc) {
+			reserve(bucket_count);
+		}
+
+		hash_table(const hash_table& other) :	_ctrl(0), _slots(0), _capacity(0), _size(0), _growth_left(0),
+												_hash(other._hash), _eq(other._eq), _alloc(other._alloc),
+												_ctrl_alloc(other._ctrl_alloc) {
+			reserve(other._size);
+			insert(other.begin(), other.end());
+		}
+
+		virtual ~hash_table(void) {
+			_release();
+		}
+
+		hash_table& operator=(const hash_table& other) {
+			if (this == &other) {
+				return *this;
+			}
+			clear();
+			_hash = other._hash;
+			_eq = other._eq;
+			reserve(other._size);
+			insert(other.begin(), other.end());
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		iterator begin(void) {
+			iterator it(_slots, _ctrl, _ctrl + _capacity);
+			if (_capacity && *_ctrl < 0) {
+				++it;
+			}
+			return it;
+		}
+
+		const_iterator begin(void) const {
+			return const_cast<hash_table*>(this)->begin();
+		}
+
+		iterator end(void) {
+			return iterator(_slots + _capacity, _ctrl + _capacity, _ctrl + _capacity);
+		}
+
+		const_iterator end(void) const {
+			return const_cast<hash_table*>(this)->end();
+		}
+
+		bool empty(void) const {
+			return _size == 0;
+		}
+
+		size_type size(void) const {
+			return _size;
+		}
+
+		size_type max_size(void) const {
+			return _alloc.max_size();
+		}
+
+		size_type bucket_count(void) const {
+			return _capacity;
+		}
+
+		float load_factor(void) const {
+			return _capacity ? static_cast<float>(_size) / _capacity : 0.0f;
+		}
+
+		float max_load_factor(void) const {
+			return 0.875f;
+		}
+
+		void clear(void) {
+			if (_capacity == 0) {
+				return ;
+			}
+			for (size_type i = 0; i < _capacity; ++i) {
+				if (_ctrl[i] >= 0) {
+					_alloc.destroy(_slots + i);
+				}
+			}
+			for (size_type i = 0; i < _capacity + ht_group::width; ++i) {
+				_ctrl[i] = HT_EMPTY;
+			}
+			_size = 0;
+			_growth_left = _capacity - _capacity / 8;
+		}
+
+		void rehash(size_type count) {
+			size_type capacity = ht_group::width;
+			while (capacity < count || capacity - capacity / 8 < _size) {
+				capacity *= 2;
+			}
+			if (count == 0 && _size == 0) {
+				_release();
+				return ;
+			}
+			_resize(capacity);
+		}
+
+		void reserve(size_type count) {
+			if (count > _size + _growth_left) {
+				size_type capacity = ht_group::width;
+				while (capacity - capacity / 8 < count) {
+					capacity *= 2;
+				}
+				_resize(capacity);
+			}
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			const key_type& key = _key_of(value);
+			std::size_t hash = _hash(key);
+			size_type pos = _find_index(key, hash);
+			if (pos != _capacity) {
+				return ft::make_pair(_iterator_at(pos), false);
+			}
+			if (_growth_left == 0) {
+				_resize(_capacity == 0 ? ht_group::width
+						: (_size * 32 <= _capacity * 25 ? _capacity : _capacity * 2));
+			}
+			pos = _find_insert_slot(hash);
+			if (_ctrl[pos] == HT_EMPTY) {
+				--_growth_left;
+			}
+			_alloc.construct(_slots + pos, value);
+			_set_ctrl(pos, _tag(hash));
+			++_size;
+			return ft::make_pair(_iterator_at(pos), true);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last,
+					typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = 0) {
+			while (first != last) {
+				insert(*first);
+				++first;
+			}
+		}
+
+		void erase(const_iterator pos) {
+			if (pos != end()) {
+				_erase_at(pos._ctrl - _ctrl);
+			}
+		}
+
+		void erase(const_iterator first, const_iterator last) {
+			while (first != last) {
+				size_type pos = first._ctrl - _ctrl;
+				++first;
+				_erase_at(pos);
+			}
+		}
+
+		size_type erase(const key_type& key) {
+			size_type pos = _find_index(key, _hash(key));
+			if (pos == _capacity) {
+				return 0;
+			}
+			_erase_at(pos);
+			return 1;
+		}
+
+		void swap(hash_table& other) {
+			std::swap(_ctrl, other._ctrl);
+			std::swap(_slots, other._slots);
+			std::swap(_capacity, other._capacity);
+			std::swap(_size, other._size);
+			std::swap(_growth_left, other._growth_left);
+			std::swap(_hash, other._hash);
+			std::swap(_eq, other._eq);
+		}
+
+		size_type count(const key_type& key) const {
+			return _find_index(key, _hash(key)) != _capacity;
+		}
+
+		iterator find(const key_type& key) {
+			size_type pos = _find_index(key, _hash(key));
+			if (pos == _capacity) {
+				return end();
+			}
+			return _iterator_at(pos);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return const_cast<hash_table*>(this)->find(key);
+		}
+
+		hasher hash_function(void) const {
+			return _hash;
+		}
+
+		key_equal key_eq(void) const {
+			return _eq;
+		}
+
+	private:
+		static signed char _tag(std::size_t hash) {
+			return static_cast<signed char>(hash & 0x7F);
+		}
+
+		iterator _iterator_at(size_type pos) {
+			return iterator(_slots + pos, _ctrl + pos, _ctrl + _capacity);
+		}
+
+		// Writes a control byte and its mirror past the end of the array.
+		void _set_ctrl(size_type pos, signed char value) {
+			_ctrl[pos] = value;
+			if (pos < ht_group::width) {
+				_ctrl[_capacity + pos] = value;
+			}
+		}
+
+		// Index of the slot holding key, or _capacity. Probing stops at the
+		// first group with an empty byte: an insert of key would have used it.
+		size_type _find_index(const key_type& key, std::size_t hash) const {
+			if (_capacity == 0) {
+				return _capacity;
+			}
+			size_type mask = _capacity - 1;
+			size_type pos = (hash >> 7) & mask;
+			signed char tag = _tag(hash);
+			for (size_type step = ht_group::width; ; step += ht_group::width) {
+				ht_group group(_ctrl + pos);
+				for (unsigned match = group.match(tag); match; match &= match - 1) {
+					size_type index = (pos + ht_group::lowest_bit(match)) & mask;
+					if (_eq(key, _key_of(_slots[index]))) {
+						return index;
+					}
+				}
+				if (group.match_empty()) {
+					return _capacity;
+				}
+				pos = (pos + step) & mask;
+			}
+		}
+
+		// First empty or deleted slot on the probe sequence of hash.
+		size_type _find_insert_slot(std::size_t hash) const {
+			size_type mask = _capacity - 1;
+			size_type pos = (hash >> 7) & mask;
+			for (size_type step = ht_group::width; ; step += ht_group::width) {
+				unsigned match = ht_group(_ctrl + pos).match_empty_or_deleted();
+				if (match) {
+					return (pos + ht_group::lowest_bit(match)) & mask;
+				}
+				pos = (pos + step) & mask;
+			}
+		}
+
+		void _erase_at(size_type pos) {
+			_alloc.destroy(_slots + pos);
+			_set_ctrl(pos, HT_DELETED);
+			--_size;
+		}
+
+		void _resize(size_type capacity) {
+			signed char*	old_ctrl = _ctrl;
+			value_type*		old_slots = _slots;
+			size_type		old_capacity = _capacity;
+
+			_ctrl = _ctrl_alloc.allocate(capacity + ht_group::width);
+			_slots = _alloc.allocate(capacity);
+			_capacity = capacity;
+			for (size_type i = 0; i < capacity + ht_group::width; ++i) {
+				_ctrl[i] = HT_EMPTY;
+			}
+			for (size_type i = 0; i < old_capacity; ++i) {
+				if (old_ctrl[i] >= 0) {
+					std::size_t hash = _hash(_key_of(old_slots[i]));
+					size_type pos = _find_insert_slot(hash);
+					_alloc.construct(_slots + pos, old_slots[i]);
+					_set_ctrl(pos, _tag(hash));
+					_alloc.destroy(old_slots + i);
+				}
+			}
+			_growth_left = capacity - capacity / 8 - _size;
+			if (old_capacity) {
+				_ctrl_alloc.deallocate(old_ctrl, old_capacity + ht_group::width);
+				_alloc.deallocate(old_slots, old_capacity);
+			}
+		}
+
+		void _release(void) {
+			if (_capacity) {
+				clear();
+				_ctrl_alloc.deallocate(_ctrl, _capacity + ht_group::width);
+				_alloc.deallocate(_slots, _capacity);
+			}
+			_ctrl = 0;
+			_slots = 0;
+			_capacity = 0;
+			_growth_left = 0;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
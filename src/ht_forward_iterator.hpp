@@ -0,0 +1,87 @@
+#ifndef HT_FORWARD_ITERATOR_HPP
+# define HT_FORWARD_ITERATOR_HPP
+
+# include <cstddef> // ptrdiff_t
+# include <iterator> //std::forward_iterator_tag
+
+namespace ft
+{
+	// Walks the slot array of a hash_table in parallel with its control
+	// bytes, skipping every slot whose control byte is not a hash tag.
+	template<class T>
+	class ht_forward_iterator {
+	public:
+		typedef std::ptrdiff_t						difference_type;
+		typedef T									value_type;
+		typedef value_type*							pointer;
+		typedef const value_type*					const_pointer;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef std::forward_iterator_tag			iterator_category;
+		pointer										_slot;
+		const signed char*							_ctrl;
+
+	private:
+		const signed char*							_end;
+
+	public:
+		ht_forward_iterator() : _slot(0), _ctrl(0), _end(0) {}
+
+		ht_forward_iterator(pointer slot, const signed char* ctrl, const signed char* end) :	_slot(slot),
+																								_ctrl(ctrl),
+																								_end(end)
+																								{}
+
+		ht_forward_iterator(const ht_forward_iterator& other) :	_slot(other._slot),
+																_ctrl(other._ctrl),
+																_end(other._end)
+																{}
+		virtual ~ht_forward_iterator() {}
+
+		ht_forward_iterator& operator=(const ht_forward_iterator& other) {
+			if (this == &other) {
+				return *this;
+			}
+			this->_slot = other._slot;
+			this->_ctrl = other._ctrl;
+			this->_end = other._end;
+			return *this;
+		}
+
+		operator ht_forward_iterator<const value_type>() const {
+			return ht_forward_iterator<const value_type>(_slot, _ctrl, _end);
+		}
+
+		reference operator*() const {
+			return *_slot;
+		}
+
+		pointer operator->() const {
+			return _slot;
+		}
+
+		ht_forward_iterator& operator++() {
+			do {
+				++_ctrl;
+				++_slot;
+			} while (_ctrl != _end && *_ctrl < 0);
+			return *this;
+		}
+
+		ht_forward_iterator operator++(int) {
+			ht_forward_iterator copy = *this;
+			operator++();
+			return copy;
+		}
+
+		bool operator==(const ht_forward_iterator& other) const {
+			return _ctrl == other._ctrl;
+		}
+
+		bool operator!=(const ht_forward_iterator& other) const {
+			return _ctrl != other._ctrl;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+#ifndef INTERVAL_MAP_HPP
+# define INTERVAL_MAP_HPP
+
+#include <memory>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "map.hpp"
+
+namespace ft
+{
+	// Half-open range [low, high) of points. An interval with low >= high
+	// is empty and overlaps nothing.
+	template<class Point>
+	struct interval {
+		typedef Point		point_type;
+
+		Point				low;
+		Point				high;
+
+		interval() : low(), high() {}
+
+		interval(const Point& low, const Point& high) : low(low), high(high) {}
+	};
+
+	template<class Point>
+	bool operator==(const interval<Point>& lhs, const interval<Point>& rhs) {
+		return lhs.low == rhs.low && lhs.high == rhs.high;
+	}
+
+	template<class Point>
+	bool operator!=(const interval<Point>& lhs, const interval<Point>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Point>
+	interval<Point> make_interval(const Point& low, const Point& high) {
+		return interval<Point>(low, high);
+	}
+
+	// Orders intervals by low endpoint, then by high endpoint.
+	template<class Point, class Compare = less<Point> >
+	struct interval_less : binary_function<interval<Point>, interval<Point>, bool> {
+		Compare comp;
+
+		interval_less(const Compare& comp = Compare()) : comp(comp) {}
+
+		bool operator()(const interval<Point>& lhs, const interval<Point>& rhs) const {
+			if (comp(lhs.low, rhs.low)) {
+				return true;
+			}
+			return !comp(rhs.low, lhs.low) && comp(lhs.high, rhs.high);
+		}
+	};
+
+	// Largest high endpoint in the subtree, under the point comparator of
+	// the tree's interval_less. A subtree whose maximum is not past the
+	// query's low endpoint cannot hold an overlap and is skipped.
+	template<class Point, class Compare = less<Point> >
+	struct interval_max_update {
+		typedef Point						metadata_type;
+		static const bool					enabled = true;
+		static const bool					ranked = false;
+		static const bool					reads_mapped = false;
+
+		template<class Node>
+		static void update(Node& node, const Node* left, const Node* right,
+							const interval_less<Point, Compare>& key_comp) {
+			const Compare& comp = key_comp.comp;
+			const Point* high = &node.data.first.high;
+			if (left && comp(*high, left->metadata)) {
+				high = &left->metadata;
+			}
+			if (right && comp(*high, right->metadata)) {
+				high = &right->metadata;
+			}
+			node.metadata = *high;
+		}
+	};
+
+	// Filter for red_black_tree::search() selecting the intervals that
+	// overlap [low, high), or that contain low when closed is set.
+	template<class Point, class Compare>
+	struct interval_overlap {
+		Point			low;
+		Point			high;
+		bool			closed;
+		Compare			comp;
+
+		interval_overlap(const Point& low, const Point& high, bool closed, const Compare& comp) :	low(low), high(high),
+																									closed(closed), comp(comp) {}
+
+		bool subtree(const Point& max_high) const {
+			return comp(low, max_high);
+		}
+
+		template<class Value>
+		bool past(const Value& value) const {
+			return closed ? comp(high, value.first.low) : !comp(value.first.low, high);
+		}
+
+		template<class Value>
+		bool match(const Value& value) const {
+			return comp(low, value.first.high) && comp(value.first.low, value.first.high);
+		}
+	};
+
+	// Map from intervals to values answering overlap and stabbing queries.
+	// It is the map red_black_tree ordered by interval_less, with every
+	// node holding the largest high endpoint below it; a query walks only
+	// the subtrees that can reach it, so a query reporting k intervals
+	// visits O(log n) nodes for each of them at most, never the whole map.
+	template<class Point, class T, class Compare = less<Point>,
+			class Allocator = std::allocator<pair<const interval<Point>, T> > >
+	class interval_map {
+	public:
+		typedef Point																	point_type;
+		typedef ft::interval<Point>														key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef interval_less<Point, Compare>											key_compare;
+		typedef Allocator																allocator_type;
+		typedef ft::red_black_tree<key_type, value_type, select_first<value_type>, key_compare,
+									Allocator, interval_max_update<Point, Compare> >	tree_type;
+		typedef value_type&																reference;
+		typedef const value_type&														const_reference;
+		typedef value_type*																pointer;
+		typedef const value_type*														const_pointer;
+		typedef std::size_t																size_type;
+		typedef std::ptrdiff_t															difference_type;
+		typedef typename tree_type::iterator											iterator;
+		typedef typename tree_type::const_iterator										const_iterator;
+		typedef typename tree_type::reverse_iterator									reverse_iterator;
+		typedef typename tree_type::const_reverse_iterator								const_reverse_iterator;
+
+	private:
+		tree_type _tree;
+
+	public:
+		explicit interval_map(const Compare& comp = Compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(key_compare(comp), alloc) {}
+
+		template<class InputIt>
+		interval_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(key_compare(comp), alloc) {
+			_tree.insert(first, last);
+		}
+
+		interval_map(const interval_map& other) : _tree(other._tree) {}
+
+		~interval_map() {
+			clear();
+		}
+
+		interval_map& operator=(const interval_map& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return allocator_type(_tree.get_allocator());
+		}
+
+		iterator begin(void) {
+			return _tree.begin();
+		}
+
+		const_iterator begin(void) const {
+			return _tree.begin();
+		}
+
+		iterator end(void) {
+			return _tree.end();
+		}
+
+		const_iterator end(void) const {
+			return _tree.end();
+		}
+
+		reverse_iterator rbegin(void) {
+			return _tree.rbegin();
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return _tree.rbegin();
+		}
+
+		reverse_iterator rend(void) {
+			return _tree.rend();
+		}
+
+		const_reverse_iterator rend(void) const {
+			return _tree.rend();
+		}
+
+		bool empty(void) const {
+			return _tree.empty();
+		}
+
+		size_type size(void) const {
+			return _tree.size();
+		}
+
+		size_type max_size(void) const {
+			return _tree.max_size();
+		}
+
+		void clear(void) {
+			_tree.clear();
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			return _tree.insert(value);
+		}
+
+		ft::pair<iterator, bool> insert(const point_type& low, const point_type& high, const mapped_type& obj) {
+			return _tree.insert(value_type(key_type(low, high), obj));
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last) {
+			_tree.insert(first, last);
+		}
+
+		void erase(iterator pos) {
+			_tree.erase(pos);
+		}
+
+		void erase(iterator first, iterator last) {
+			_tree.erase(first, last);
+		}
+
+		size_type erase(const key_type& key) {
+			return _tree.erase(key);
+		}
+
+		size_type count(const key_type& key) const {
+			return _tree.count(key);
+		}
+
+		iterator find(const key_type& key) {
+			return _tree.find(key);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return _tree.find(key);
+		}
+
+		// Writes to out a const_iterator to every interval overlapping
+		// [low, high), in key order.
+		template<class OutputIterator>
+		OutputIterator overlapping(const point_type& low, const point_type& high, OutputIterator out) const {
+			Compare comp = _tree.key_comp().comp;
+			if (!comp(low, high)) {
+				return out;
+			}
+			return _tree.search(interval_overlap<Point, Compare>(low, high, false, comp), out);
+		}
+
+		// Writes to out a const_iterator to every interval containing point.
+		template<class OutputIterator>
+		OutputIterator stabbing(const point_type& point, OutputIterator out) const {
+			return _tree.search(interval_overlap<Point, Compare>(point, point, true, _tree.key_comp().comp), out);
+		}
+
+		key_compare key_comp(void) const {
+			return _tree.key_comp();
+		}
+	};
+
+	template<class Point, class T, class Compare, class Alloc>
+	bool operator==(const interval_map<Point, T, Compare, Alloc>& lhs, const interval_map<Point, T, Compare, Alloc>& rhs) {
+		return ft::equal(lhs.begin(), lhs.end(), rhs.begin()) && lhs.size() == rhs.size();
+	}
+
+	template<class Point, class T, class Compare, class Alloc>
+	bool operator!=(const interval_map<Point, T, Compare, Alloc>& lhs, const interval_map<Point, T, Compare, Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef MULTIMAP_HPP
+# define MULTIMAP_HPP
+
+#include <memory>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "map.hpp"
+#include "rbt_bidirectional_iterator.hpp"
+#include "../utils/equal.hpp"
+#include "../utils/lexicographical_compare.hpp"
+
+namespace ft
+{
+	// Ordered map with equal keys, on the same red_black_tree as ft::map.
+	// Equal keys sit next to each other in insertion order. The default
+	// tree keeps subtree sizes, so count() is O(log n) however many
+	// elements share the key; a plain red_black_tree saves the size field
+	// at O(log n + count) per count().
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> >,
+			class Tree = typename ft::rb_ranked_map_tree<Key, T, Compare, Allocator>::type>
+	class multimap {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef Tree																	tree_type;
+		typedef value_type&																reference;
+		typedef const value_type&														const_reference;
+		typedef value_type*																pointer;
+		typedef const value_type*														const_pointer;
+		typedef std::size_t																size_type;
+		typedef std::ptrdiff_t															difference_type;
+		typedef typename tree_type::iterator											iterator;
+		typedef typename tree_type::const_iterator										const_iterator;
+		typedef typename tree_type::reverse_iterator									reverse_iterator;
+		typedef typename tree_type::const_reverse_iterator								const_reverse_iterator;
+
+		class value_compare : public ft::binary_function<value_type, value_type, bool> {
+			friend class multimap;
+			protected:
+				key_compare _comp;
+				value_compare(key_compare c) : _comp(c) {}
+			public:
+				bool operator()(const value_type& lhs, const value_type& rhs) const {
+					return _comp(lhs.first, rhs.first);
+				}
+		};
+
+	private:
+		tree_type _tree;
+
+	public:
+		explicit multimap(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, allocator_type(alloc)) {}
+
+		template<class InputIt>
+		multimap(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, allocator_type(alloc)) {
+			_tree.insert_multi(first, last);
+		}
+
+		multimap(const multimap& other) : _tree(other._tree) {}
+
+		~multimap() {
+			clear();
+		}
+
+		multimap& operator=(const multimap& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return allocator_type(_tree.get_allocator());
+		}
+
+		iterator begin(void) {
+			return _tree.begin();
+		}
+
+		const_iterator begin(void) const {
+			return _tree.begin();
+		}
+
+		iterator end(void) {
+			return _tree.end();
+		}
+
+		const_iterator end(void) const {
+			return _tree.end();
+		}
+
+		reverse_iterator rbegin(void) {
+			return _tree.rbegin();
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return _tree.rbegin();
+		}
+
+		reverse_iterator rend(void) {
+			return _tree.rend();
+		}
+
+		const_reverse_iterator rend(void) const {
+			return _tree.rend();
+		}
+
+		bool empty(void) const {
+			return _tree.empty();
+		}
+
+		size_type size(void) const {
+			return _tree.size();
+		}
+
+		size_type max_size(void) const {
+			return _tree.max_size();
+		}
+
+		void clear(void) {
+			_tree.clear();
+		}
+
+		// Always inserts, after the elements with an equal key.
+		iterator insert(const value_type& value) {
+			return _tree.insert_multi(value);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return _tree.insert_multi(value);
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last) {
+			_tree.insert_multi(first, last);
+		}
+
+		void erase(iterator pos) {
+			_tree.erase(pos);
+		}
+
+		void erase(iterator first, iterator last) {
+			_tree.erase(first, last);
+		}
+
+		// Erases every element with an equal key and returns how many.
+		size_type erase(const key_type& key) {
+			return _tree.erase_multi(key);
+		}
+
+		void swap(multimap& other) {
+			multimap tmp = *this;
+			*this = other;
+			other = tmp;
+		}
+
+		size_type count(const key_type& key) const {
+			return _tree.count_multi(key);
+		}
+
+		// The first element with an equal key.
+		iterator find(const key_type& key) {
+			return _tree.find(key);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return _tree.find(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			return _tree.equal_range_multi(key);
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			return _tree.equal_range_multi(key);
+		}
+
+		iterator lower_bound(const key_type& key) {
+			return _tree.lower_bound(key);
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			return _tree.lower_bound(key);
+		}
+
+		iterator upper_bound(const key_type& key) {
+			return _tree.upper_bound(key);
+		}
+
+		const_iterator upper_bound(const key_type& key) const {
+			return _tree.upper_bound(key);
+		}
+
+		// Heterogeneous lookups, for a transparent Compare.
+		template<class K>
+		typename enable_if_transparent<Compare, K, size_type>::type count(const K& key) const {
+			return _tree.count_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type find(const K& key) {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type find(const K& key) const {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+			return _tree.equal_range_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<const_iterator, const_iterator> >::type
+		equal_range(const K& key) const {
+			return _tree.equal_range_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type lower_bound(const K& key) {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type lower_bound(const K& key) const {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type upper_bound(const K& key) {
+			return _tree.upper_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type upper_bound(const K& key) const {
+			return _tree.upper_bound(key);
+		}
+
+		key_compare key_comp(void) const {
+			return _tree.key_comp();
+		}
+
+		value_compare value_comp(void) const {
+			return value_compare(key_comp());
+		}
+	};
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator==(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator!=(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator<(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator<=(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return lhs < rhs || lhs == rhs;
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator>(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return rhs < lhs;
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator>=(const multimap<Key, T, Compare, Alloc, Tree>& lhs, const multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		return rhs <= lhs;
+	}
+
+	template<class Key, class T, class Compare, class Alloc, class Tree>
+	void swap(multimap<Key, T, Compare, Alloc, Tree>& lhs, multimap<Key, T, Compare, Alloc, Tree>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif
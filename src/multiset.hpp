@@ -0,0 +1,278 @@
+#ifndef MULTISET_HPP
+# define MULTISET_HPP
+
+#include <memory>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "set.hpp"
+#include "rbt_bidirectional_iterator.hpp"
+#include "../utils/equal.hpp"
+#include "../utils/lexicographical_compare.hpp"
+
+namespace ft
+{
+	// Ordered set with equal keys, on the same red_black_tree as ft::set.
+	// As with ft::multimap, the default tree keeps subtree sizes so that
+	// count() is O(log n).
+	template<class Key, class Compare = ft::less<Key>,
+			class Allocator = std::allocator<Key>,
+			class Tree = typename ft::rb_ranked_set_tree<Key, Compare, Allocator>::type>
+	class multiset {
+	public:
+		typedef Key																		key_type;
+		typedef Key																		value_type;
+		typedef std::size_t																size_type;
+		typedef std::ptrdiff_t															difference_type;
+		typedef Compare																	key_compare;
+		typedef Compare																	value_compare;
+		typedef Allocator																allocator_type;
+		typedef Tree																	tree_type;
+		typedef value_type&																reference;
+		typedef const value_type&														const_reference;
+		typedef value_type*																pointer;
+		typedef const value_type*														const_pointer;
+		typedef typename tree_type::iterator											iterator;
+		typedef typename tree_type::const_iterator										const_iterator;
+		typedef typename tree_type::reverse_iterator									reverse_iterator;
+		typedef typename tree_type::const_reverse_iterator								const_reverse_iterator;
+
+		private:
+			tree_type _tree;
+
+	public:
+		explicit multiset(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, allocator_type(alloc)) {}
+
+		template<class InputIt>
+		multiset(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, allocator_type(alloc)) {
+			_tree.insert_multi(first, last);
+		}
+
+		multiset(const multiset& other) : _tree(other._tree) {}
+
+		~multiset() {
+			clear();
+		}
+
+		multiset& operator=(const multiset& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return allocator_type(_tree.get_allocator());
+		}
+
+		iterator begin(void) {
+			return _tree.begin();
+		}
+
+		const_iterator begin(void) const {
+			return _tree.begin();
+		}
+
+		iterator end(void) {
+			return _tree.end();
+		}
+
+		const_iterator end(void) const {
+			return _tree.end();
+		}
+
+		reverse_iterator rbegin(void) {
+			return _tree.rbegin();
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return _tree.rbegin();
+		}
+
+		reverse_iterator rend(void) {
+			return _tree.rend();
+		}
+
+		const_reverse_iterator rend(void) const {
+			return _tree.rend();
+		}
+
+		bool empty(void) const {
+			return _tree.empty();
+		}
+
+		size_type size(void) const {
+			return _tree.size();
+		}
+
+		size_type max_size(void) const {
+			return _tree.max_size();
+		}
+
+		void clear(void) {
+			_tree.clear();
+		}
+
+		// Always inserts, after the equal elements.
+		iterator insert(const value_type& value) {
+			return _tree.insert_multi(value);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return _tree.insert_multi(value);
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last) {
+			_tree.insert_multi(first, last);
+		}
+
+		void erase(iterator pos) {
+			_tree.erase(pos);
+		}
+
+		void erase(iterator first, iterator last) {
+			_tree.erase(first, last);
+		}
+
+		// Erases every element equal to key and returns how many.
+		size_type erase(const key_type& key) {
+			return _tree.erase_multi(key);
+		}
+
+		void swap(multiset& other) {
+			multiset tmp = *this;
+			*this = other;
+			other = tmp;
+		}
+
+		size_type count(const key_type& key) const {
+			return _tree.count_multi(key);
+		}
+
+		// The first element equal to key.
+		iterator find(const key_type& key) {
+			return _tree.find(key);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return _tree.find(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			return _tree.equal_range_multi(key);
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			return _tree.equal_range_multi(key);
+		}
+
+		iterator lower_bound(const key_type& key) {
+			return _tree.lower_bound(key);
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			return _tree.lower_bound(key);
+		}
+
+		iterator upper_bound(const key_type& key) {
+			return _tree.upper_bound(key);
+		}
+
+		const_iterator upper_bound(const key_type& key) const {
+			return _tree.upper_bound(key);
+		}
+
+		// Heterogeneous lookups, for a transparent Compare.
+		template<class K>
+		typename enable_if_transparent<Compare, K, size_type>::type count(const K& key) const {
+			return _tree.count_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type find(const K& key) {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type find(const K& key) const {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+			return _tree.equal_range_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<const_iterator, const_iterator> >::type
+		equal_range(const K& key) const {
+			return _tree.equal_range_multi(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type lower_bound(const K& key) {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type lower_bound(const K& key) const {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type upper_bound(const K& key) {
+			return _tree.upper_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type upper_bound(const K& key) const {
+			return _tree.upper_bound(key);
+		}
+
+		key_compare key_comp(void) const {
+			return _tree.key_comp();
+		}
+
+		value_compare value_comp(void) const {
+			return value_compare(key_comp());
+		}
+	};
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator==(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator!=(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator<(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator<=(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return lhs < rhs || lhs == rhs;
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator>(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return rhs < lhs;
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator>=(const multiset<Key, Compare, Alloc, Tree>& lhs, const multiset<Key, Compare, Alloc, Tree>& rhs) {
+		return rhs <= lhs;
+	}
+
+	template<class Key, class Compare, class Alloc, class Tree>
+	void swap(multiset<Key, Compare, Alloc, Tree>& lhs, multiset<Key, Compare, Alloc, Tree>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,530 @@
+#ifndef PERSISTENT_MAP_HPP
+# define PERSISTENT_MAP_HPP
+
+#include <memory>
+#include <iterator>
+#include <stdexcept>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "../utils/atomic.hpp"
+#include "../utils/lock.hpp"
+#include "../utils/equal.hpp"
+#include "rbt_node.hpp"
+
+namespace ft
+{
+	// Node of a persistent_map. Never changed once another version can
+	// see it; refs counts the parents and map versions pointing at it.
+	template<class Value>
+	struct persistent_node {
+		Value					value;
+		persistent_node*		left;
+		persistent_node*		right;
+		std::size_t				refs;
+		ft::color				color;
+
+		persistent_node(const Value& v, ft::color c, persistent_node* l, persistent_node* r)
+			: value(v), left(l), right(r), refs(1), color(c) {}
+	};
+
+	// A red-black tree that is never changed in place. An update copies
+	// the O(log n) nodes on the path to the key and shares every other
+	// subtree with the version before it, so copying the map, or taking
+	// snapshot(), is O(1): both versions point at the same root and each
+	// sees the tree as it was. Nodes count their references; a node is
+	// freed when the last version that can reach it is gone.
+	//
+	// Insertion and erasure are Kahrs' functional red-black algorithms,
+	// which need no parent pointers: a shared node has many parents.
+	//
+	// Threads: writers to one map take turns on a mutex. A new version is
+	// published by swapping the root under a second lock held only for a
+	// pointer copy, which is all snapshot() takes; a reader then works on
+	// its snapshot without any lock and sees every write either whole or
+	// not at all. Reads on the map object itself are for the thread that
+	// writes it; other threads read a snapshot.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	class persistent_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef std::size_t																size_type;
+
+	private:
+		typedef persistent_node<value_type>												_node;
+		typedef typename Allocator::template rebind<_node>::other						_node_allocator;
+
+		// Longest root-to-leaf path of a red-black tree under 2^48 nodes.
+		static const int				_max_depth = 96;
+
+		_node*							_root;
+		size_type						_size;
+		key_compare						_comp;
+		_node_allocator					_alloc;
+		mutable ft::mutex				_root_lock;
+		ft::mutex						_write_lock;
+
+	public:
+		// In-order walk with the path kept on a fixed stack, as nodes have
+		// no parent pointers. Valid while the version it walks is alive.
+		class const_iterator {
+		public:
+			typedef std::ptrdiff_t								difference_type;
+			typedef typename persistent_map::value_type			value_type;
+			typedef const value_type*							pointer;
+			typedef const value_type&							reference;
+			typedef std::forward_iterator_tag					iterator_category;
+
+			const_iterator(void) : _depth(0) {}
+
+			reference operator*(void) const {
+				return _path[_depth - 1]->value;
+			}
+
+			pointer operator->(void) const {
+				return &_path[_depth - 1]->value;
+			}
+
+			const_iterator& operator++(void) {
+				const _node* node = _path[--_depth]->right;
+				_push_left(node);
+				return *this;
+			}
+
+			const_iterator operator++(int) {
+				const_iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			bool operator==(const const_iterator& other) const {
+				if (_depth != other._depth) {
+					return false;
+				}
+				return !_depth || _path[_depth - 1] == other._path[_depth - 1];
+			}
+
+			bool operator!=(const const_iterator& other) const {
+				return !(*this == other);
+			}
+
+		private:
+			friend class persistent_map;
+
+			const _node*	_path[_max_depth];
+			int				_depth;
+
+			void _push_left(const _node* node) {
+				for (; node; node = node->left) {
+					_path[_depth++] = node;
+				}
+			}
+		};
+
+		typedef const_iterator															iterator;
+
+		explicit persistent_map(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _root(0), _size(0), _comp(comp), _alloc(alloc) {}
+
+		template<class InputIt>
+		persistent_map(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _root(0), _size(0), _comp(comp), _alloc(alloc) {
+			for (; first != last; ++first) {
+				insert(*first);
+			}
+		}
+
+		// O(1): shares other's current version.
+		persistent_map(const persistent_map& other) : _root(0), _size(0), _comp(other._comp), _alloc(other._alloc) {
+			ft::lock_guard<ft::mutex> guard(other._root_lock);
+			_root = _share(other._root);
+			_size = other._size;
+		}
+
+		~persistent_map(void) {
+			_release(_root);
+		}
+
+		persistent_map& operator=(const persistent_map& other) {
+			if (this == &other) {
+				return *this;
+			}
+			persistent_map copy(other);
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			_publish(_share(copy._root), copy._size);
+			return *this;
+		}
+
+		// The current version, O(1). Safe while other threads write.
+		persistent_map snapshot(void) const {
+			return persistent_map(*this);
+		}
+
+		allocator_type get_allocator(void) const {
+			return allocator_type(_alloc);
+		}
+
+		const_iterator begin(void) const {
+			const_iterator it;
+			it._push_left(_root);
+			return it;
+		}
+
+		const_iterator end(void) const {
+			return const_iterator();
+		}
+
+		bool empty(void) const {
+			return _size == 0;
+		}
+
+		size_type size(void) const {
+			return _size;
+		}
+
+		size_type max_size(void) const {
+			return _alloc.max_size();
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			const_iterator it;
+			for (const _node* node = _root; node;) {
+				if (_comp(node->value.first, key)) {
+					node = node->right;
+				} else {
+					it._path[it._depth++] = node;
+					node = node->left;
+				}
+			}
+			return it;
+		}
+
+		const_iterator find(const key_type& key) const {
+			const_iterator it = lower_bound(key);
+			if (it != end() && _comp(key, it->first)) {
+				return end();
+			}
+			return it;
+		}
+
+		// Copies the value out without building an iterator's path.
+		bool find(const key_type& key, mapped_type& obj) const {
+			const _node* node = _search(key);
+			if (!node) {
+				return false;
+			}
+			obj = node->value.second;
+			return true;
+		}
+
+		size_type count(const key_type& key) const {
+			return _search(key) ? 1 : 0;
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			const _node* node = _search(key);
+			if (!node) {
+				throw std::out_of_range("Out of range");
+			}
+			return node->value.second;
+		}
+
+		// Writes copy the path to key; a write that changes nothing copies
+		// nothing. True if an element was added.
+		bool insert(const value_type& value) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			if (_search(value.first)) {
+				return false;
+			}
+			_publish(_blacken(_insert(_root, value)), _size + 1);
+			return true;
+		}
+
+		bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			if (!_search(key)) {
+				_publish(_blacken(_insert(_root, value_type(key, obj))), _size + 1);
+				return true;
+			}
+			_publish(_assign(_root, key, obj), _size);
+			return false;
+		}
+
+		size_type erase(const key_type& key) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			if (!_search(key)) {
+				return 0;
+			}
+			_publish(_blacken(_erase(_root, key)), _size - 1);
+			return 1;
+		}
+
+		void clear(void) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			_publish(0, 0);
+		}
+
+		void swap(persistent_map& other) {
+			persistent_map tmp(*this);
+			*this = other;
+			other = tmp;
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+	private:
+		const _node* _search(const key_type& key) const {
+			const _node* node = _root;
+			while (node) {
+				if (_comp(key, node->value.first)) {
+					node = node->left;
+				} else if (_comp(node->value.first, key)) {
+					node = node->right;
+				} else {
+					return node;
+				}
+			}
+			return 0;
+		}
+
+		// Makes root (already owned) the current version.
+		void _publish(_node* root, size_type size) {
+			_node* old;
+			{
+				ft::lock_guard<ft::mutex> guard(_root_lock);
+				old = _root;
+				_root = root;
+				_size = size;
+			}
+			_release(old);
+		}
+
+		// Reference counting. Functions below take the subtrees they are
+		// given as owned and return an owned tree; _share turns a borrowed
+		// pointer into an owned one.
+		static _node* _share(_node* node) {
+			if (node) {
+				atomic_fetch_add(&node->refs, 1);
+			}
+			return node;
+		}
+
+		void _release(_node* node) {
+			while (node && atomic_fetch_sub(&node->refs, 1) == 1) {
+				_node* right = node->right;
+				_release(node->left);
+				_alloc.destroy(node);
+				_alloc.deallocate(node, 1);
+				node = right;
+			}
+		}
+
+		_node* _make(ft::color color, _node* left, const value_type& value, _node* right) {
+			_node* node = _alloc.allocate(1);
+			_alloc.construct(node, _node(value, color, left, right));
+			return node;
+		}
+
+		// A copy of node (borrowed) with its children shared.
+		_node* _recolor(const _node* node, ft::color color) {
+			return _make(color, _share(node->left), node->value, _share(node->right));
+		}
+
+		static bool _is_red(const _node* node) {
+			return node && node->color == RED;
+		}
+
+		static bool _is_black(const _node* node) {
+			return node && node->color == BLACK;
+		}
+
+		// The root of a new version is black. A node only this call holds
+		// is recolored in place.
+		_node* _blacken(_node* root) {
+			if (!_is_red(root)) {
+				return root;
+			}
+			if (atomic_load(&root->refs) == 1) {
+				root->color = BLACK;
+				return root;
+			}
+			_node* black = _recolor(root, BLACK);
+			_release(root);
+			return black;
+		}
+
+		// Rebuilds a black node over left, value and right, fixing a red
+		// child with a red child below it.
+		_node* _balance(_node* left, const value_type& value, _node* right) {
+			_node* result;
+			if (_is_red(left) && _is_red(right)) {
+				result = _make(RED, _recolor(left, BLACK), value, _recolor(right, BLACK));
+				_release(left);
+				_release(right);
+			} else if (_is_red(left) && _is_red(left->left)) {
+				result = _make(RED, _recolor(left->left, BLACK), left->value,
+								_make(BLACK, _share(left->right), value, right));
+				_release(left);
+			} else if (_is_red(left) && _is_red(left->right)) {
+				_node* mid = left->right;
+				result = _make(RED, _make(BLACK, _share(left->left), left->value, _share(mid->left)), mid->value,
+								_make(BLACK, _share(mid->right), value, right));
+				_release(left);
+			} else if (_is_red(right) && _is_red(right->right)) {
+				result = _make(RED, _make(BLACK, left, value, _share(right->left)), right->value,
+								_recolor(right->right, BLACK));
+				_release(right);
+			} else if (_is_red(right) && _is_red(right->left)) {
+				_node* mid = right->left;
+				result = _make(RED, _make(BLACK, left, value, _share(mid->left)), mid->value,
+								_make(BLACK, _share(mid->right), right->value, _share(right->right)));
+				_release(right);
+			} else {
+				result = _make(BLACK, left, value, right);
+			}
+			return result;
+		}
+
+		// node is borrowed; key is known to be absent.
+		_node* _insert(const _node* node, const value_type& value) {
+			if (!node) {
+				return _make(RED, 0, value, 0);
+			}
+			if (_comp(value.first, node->value.first)) {
+				_node* left = _insert(node->left, value);
+				if (node->color == BLACK) {
+					return _balance(left, node->value, _share(node->right));
+				}
+				return _make(RED, left, node->value, _share(node->right));
+			}
+			_node* right = _insert(node->right, value);
+			if (node->color == BLACK) {
+				return _balance(_share(node->left), node->value, right);
+			}
+			return _make(RED, _share(node->left), node->value, right);
+		}
+
+		// node is borrowed; key is known to be present.
+		_node* _assign(const _node* node, const key_type& key, const mapped_type& obj) {
+			if (_comp(key, node->value.first)) {
+				return _make(node->color, _assign(node->left, key, obj), node->value, _share(node->right));
+			}
+			if (_comp(node->value.first, key)) {
+				return _make(node->color, _share(node->left), node->value, _assign(node->right, key, obj));
+			}
+			return _make(node->color, _share(node->left), value_type(node->value.first, obj), _share(node->right));
+		}
+
+		// A red node with a black child a level short on its left or right
+		// (left and right owned), rebalanced.
+		_node* _balance_left(_node* left, const value_type& value, _node* right) {
+			_node* result;
+			if (_is_red(left)) {
+				result = _make(RED, _recolor(left, BLACK), value, right);
+				_release(left);
+			} else if (_is_black(right)) {
+				result = _balance(left, value, _recolor(right, RED));
+				_release(right);
+			} else {
+				_node* mid = right->left;
+				result = _make(RED, _make(BLACK, left, value, _share(mid->left)), mid->value,
+								_balance(_share(mid->right), right->value, _recolor(right->right, RED)));
+				_release(right);
+			}
+			return result;
+		}
+
+		_node* _balance_right(_node* left, const value_type& value, _node* right) {
+			_node* result;
+			if (_is_red(right)) {
+				result = _make(RED, left, value, _recolor(right, BLACK));
+				_release(right);
+			} else if (_is_black(left)) {
+				result = _balance(_recolor(left, RED), value, right);
+				_release(left);
+			} else {
+				_node* mid = left->right;
+				result = _make(RED, _balance(_recolor(left->left, RED), left->value, _share(mid->left)), mid->value,
+								_make(BLACK, _share(mid->right), value, right));
+				_release(left);
+			}
+			return result;
+		}
+
+		// Joins the two children of an erased node (both borrowed), all of
+		// left's keys before right's.
+		_node* _fuse(const _node* left, const _node* right) {
+			if (!left) {
+				return _share(const_cast<_node*>(right));
+			}
+			if (!right) {
+				return _share(const_cast<_node*>(left));
+			}
+			if (_is_red(left) && _is_red(right)) {
+				_node* mid = _fuse(left->right, right->left);
+				if (_is_red(mid)) {
+					_node* result = _make(RED, _make(RED, _share(left->left), left->value, _share(mid->left)), mid->value,
+											_make(RED, _share(mid->right), right->value, _share(right->right)));
+					_release(mid);
+					return result;
+				}
+				return _make(RED, _share(left->left), left->value, _make(RED, mid, right->value, _share(right->right)));
+			}
+			if (_is_black(left) && _is_black(right)) {
+				_node* mid = _fuse(left->right, right->left);
+				if (_is_red(mid)) {
+					_node* result = _make(RED, _make(BLACK, _share(left->left), left->value, _share(mid->left)), mid->value,
+											_make(BLACK, _share(mid->right), right->value, _share(right->right)));
+					_release(mid);
+					return result;
+				}
+				return _balance_left(_share(left->left), left->value,
+									_make(BLACK, mid, right->value, _share(right->right)));
+			}
+			if (_is_red(right)) {
+				return _make(RED, _fuse(left, right->left), right->value, _share(right->right));
+			}
+			return _make(RED, _share(left->left), left->value, _fuse(left->right, right));
+		}
+
+		// node is borrowed; key is known to be present.
+		_node* _erase(const _node* node, const key_type& key) {
+			if (_comp(key, node->value.first)) {
+				if (_is_black(node->left)) {
+					return _balance_left(_erase(node->left, key), node->value, _share(node->right));
+				}
+				return _make(RED, _erase(node->left, key), node->value, _share(node->right));
+			}
+			if (_comp(node->value.first, key)) {
+				if (_is_black(node->right)) {
+					return _balance_right(_share(node->left), node->value, _erase(node->right, key));
+				}
+				return _make(RED, _share(node->left), node->value, _erase(node->right, key));
+			}
+			return _fuse(node->left, node->right);
+		}
+	};
+
+	template<class Key, class T, class Compare, class Alloc>
+	bool operator==(const persistent_map<Key, T, Compare, Alloc>& lhs, const persistent_map<Key, T, Compare, Alloc>& rhs) {
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template<class Key, class T, class Compare, class Alloc>
+	bool operator!=(const persistent_map<Key, T, Compare, Alloc>& lhs, const persistent_map<Key, T, Compare, Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class T, class Compare, class Alloc>
+	void swap(persistent_map<Key, T, Compare, Alloc>& lhs, persistent_map<Key, T, Compare, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,705 @@
+#ifndef RB_ARENA_TREE_HPP
+# define RB_ARENA_TREE_HPP
+
+# include <cstddef>
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include <stdint.h>
+# include "../utils/pair.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/type_traits.hpp"
+# include "vector.hpp"
+# include "rbt_node.hpp"
+# include "bplus_tree.hpp" // bpt_mapped_type
+# include "rba_bidirectional_iterator.hpp"
+
+namespace ft
+{
+	// Node of an rb_arena_tree: links are 32-bit arena indices and the color
+	// sits in the low bit of the parent index, so a set<int> node is 16 bytes.
+	// The value lives in raw storage and is only constructed while the node
+	// is in the tree; a free node is marked by an impossible parent index.
+	template<class T>
+	struct rba_node {
+		typedef T														value_type;
+		typedef uint32_t												index_type;
+
+		static const index_type											free_mark = 0xFFFFFFFF;
+
+		index_type														parent_color;
+		index_type														left;
+		index_type														right;
+		typename aligned_storage<sizeof(T), alignment_of<T>::value>::type	storage;
+
+		rba_node() : parent_color(free_mark), left(0), right(0) {}
+
+		// Used when the arena grows and relocates its nodes.
+		rba_node(const rba_node& other) :	parent_color(other.parent_color),
+											left(other.left),
+											right(other.right) {
+			if (other.in_use()) {
+				new (storage.data) value_type(other.data());
+			}
+		}
+
+		~rba_node() {
+			if (in_use()) {
+				data().~value_type();
+			}
+		}
+
+		value_type& data(void) {
+			return *reinterpret_cast<value_type*>(storage.data);
+		}
+
+		const value_type& data(void) const {
+			return *reinterpret_cast<const value_type*>(storage.data);
+		}
+
+		bool in_use(void) const {
+			return parent_color != free_mark;
+		}
+
+		// Constructs the value; the node becomes a red leaf without a parent.
+		void construct(const value_type& value) {
+			new (storage.data) value_type(value);
+			parent_color = RED;
+			left = 0;
+			right = 0;
+		}
+
+		void destroy(void) {
+			data().~value_type();
+			parent_color = free_mark;
+		}
+
+		// Loads both links and indexes them, so a descent picks a side
+		// without a mispredicted branch per level.
+		index_type child(bool right_side) const {
+			const index_type links[2] = {left, right};
+			return links[right_side];
+		}
+
+		index_type parent(void) const {
+			return parent_color >> 1;
+		}
+
+		void set_parent(index_type parent) {
+			parent_color = (parent << 1) | (parent_color & 1);
+		}
+
+		ft::color color(void) const {
+			return static_cast<ft::color>(parent_color & 1);
+		}
+
+		void set_color(ft::color color) {
+			parent_color = (parent_color & ~static_cast<index_type>(1)) | color;
+		}
+
+	private:
+		rba_node& operator=(const rba_node&);
+	};
+
+	// Node storage of an rb_arena_tree: one ft::vector of nodes, addressed by
+	// index. Growing the vector relocates the nodes, which invalidates
+	// references to values but not iterators, since those hold indices.
+	// Index 0 is nil and is never handed out; freed nodes are chained through
+	// their right link and reused first.
+	template<class T, class Allocator>
+	class rba_arena {
+	public:
+		typedef T																value_type;
+		typedef rba_node<T>														node_type;
+		typedef uint32_t														index_type;
+
+		static const index_type nil = 0;
+		// One bit of the parent link holds the color, and the parent field
+		// of a free node is all ones.
+		static const index_type max_nodes = 0x7FFFFFFE;
+
+	private:
+		typedef typename Allocator::template rebind<node_type>::other			node_allocator;
+
+		ft::vector<node_type, node_allocator>	_nodes;
+		index_type								_free;
+
+		rba_arena(const rba_arena&);
+		rba_arena& operator=(const rba_arena&);
+
+	public:
+		index_type								root;
+
+		explicit rba_arena(const Allocator& alloc) : _nodes(node_allocator(alloc)), _free(nil), root(nil) {}
+
+		node_type& operator[](index_type index) {
+			return _nodes[index];
+		}
+
+		const node_type& operator[](index_type index) const {
+			return _nodes[index];
+		}
+
+		index_type minimum(index_type node) const {
+			while (_nodes[node].left != nil) {
+				node = _nodes[node].left;
+			}
+			return node;
+		}
+
+		index_type maximum(index_type node) const {
+			if (node == nil) {
+				return nil;
+			}
+			while (_nodes[node].right != nil) {
+				node = _nodes[node].right;
+			}
+			return node;
+		}
+
+		// A free node; the caller constructs it. May relocate every node.
+		index_type allocate(void) {
+			if (_free != nil) {
+				index_type index = _free;
+				_free = _nodes[index].right;
+				return index;
+			}
+			if (_nodes.empty()) {
+				_nodes.push_back(node_type());
+			}
+			_nodes.push_back(node_type());
+			return static_cast<index_type>(_nodes.size() - 1);
+		}
+
+		// The caller has destroyed the node.
+		void deallocate(index_type index) {
+			_nodes[index].right = _free;
+			_free = index;
+		}
+
+		// Destroys every node and gives the memory back.
+		void release(void) {
+			ft::vector<node_type, node_allocator> empty(_nodes.get_allocator());
+			_nodes.swap(empty);
+			_free = nil;
+			root = nil;
+		}
+
+		std::size_t max_size(void) const {
+			return _nodes.max_size() < max_nodes ? _nodes.max_size() : max_nodes;
+		}
+	};
+
+	// Red-black tree with the interface of red_black_tree whose nodes live in
+	// an rba_arena and link through 32-bit indices instead of pointers. That
+	// halves the link overhead on 64-bit targets and packs the nodes into one
+	// block. Unlike red_black_tree, an insert that grows the arena moves the
+	// values, so references to elements do not survive it; iterators do.
+	// Holds at most rba_arena::max_nodes elements.
+	template<class Key, class Value, class KeyOfValue, class Compare = less<Key>,
+			class Allocator = std::allocator<Value> >
+	class rb_arena_tree {
+	public:
+		typedef Key																key_type;
+		typedef Value															value_type;
+		typedef typename bpt_mapped_type<Value>::type							mapped_type;
+		typedef Compare															key_compare;
+		typedef Allocator														allocator_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef rba_arena<value_type, allocator_type>							arena_type;
+		typedef typename arena_type::node_type									node_type;
+		typedef typename arena_type::index_type									index_type;
+		typedef ft::rba_bidirectional_iterator<arena_type>						iterator;
+		typedef ft::rba_bidirectional_iterator<const arena_type>				const_iterator;
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+
+	private:
+		static const index_type nil = arena_type::nil;
+
+		arena_type		_arena;
+		key_compare		_comp;
+		size_type		_size;
+		allocator_type	_alloc;
+		KeyOfValue		_key_of;
+
+	public:
+		explicit rb_arena_tree(const key_compare& comp = key_compare(),
+								const allocator_type& alloc = allocator_type()) :	_arena(alloc), _comp(comp),
+																					_size(0), _alloc(alloc) {}
+
+		template<class InputIt>
+		rb_arena_tree(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+						const allocator_type& alloc = allocator_type()) :	_arena(alloc), _comp(comp),
+																			_size(0), _alloc(alloc) {
+			insert(first, last);
+		}
+
+		rb_arena_tree(const rb_arena_tree& other) :	_arena(other._alloc), _comp(other._comp),
+													_size(0), _alloc(other._alloc) {
+			insert(other.begin(), other.end());
+		}
+
+		virtual ~rb_arena_tree(void) {
+			clear();
+		}
+
+		rb_arena_tree& operator=(const rb_arena_tree& other) {
+			if (this == &other) {
+				return *this;
+			}
+			clear();
+			_comp = other._comp;
+			insert(other.begin(), other.end());
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		mapped_type& at(const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return _arena[it._index].data().second;
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			const_iterator it = find(key);
+			if (it == end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return _arena[it._index].data().second;
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				it = insert(value_type(key, mapped_type())).first;
+			}
+			return _arena[it._index].data().second;
+		}
+
+		iterator begin(void) {
+			return iterator(_first(), &_arena);
+		}
+
+		const_iterator begin(void) const {
+			return const_iterator(_first(), &_arena);
+		}
+
+		iterator end(void) {
+			return iterator(nil, &_arena);
+		}
+
+		const_iterator end(void) const {
+			return const_iterator(nil, &_arena);
+		}
+
+		reverse_iterator rbegin(void) {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend(void) {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend(void) const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool empty(void) const {
+			return _size == 0;
+		}
+
+		size_type size(void) const {
+			return _size;
+		}
+
+		size_type max_size(void) const {
+			return _arena.max_size();
+		}
+
+		void clear(void) {
+			_arena.release();
+			_size = 0;
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			const key_type& key = _key_of(value);
+			index_type parent = nil;
+			index_type current = _arena.root;
+			bool left = true;
+			while (current != nil) {
+				parent = current;
+				if (_comp(key, _key(current))) {
+					left = true;
+					current = _arena[current].left;
+				} else if (_comp(_key(current), key)) {
+					left = false;
+					current = _arena[current].right;
+				} else {
+					return ft::make_pair(iterator(current, &_arena), false);
+				}
+			}
+			if (_size == arena_type::max_nodes) {
+				throw std::length_error("rb_arena_tree");
+			}
+			index_type node = _create_node(value);
+			_arena[node].set_parent(parent);
+			if (parent == nil) {
+				_arena.root = node;
+			} else if (left) {
+				_arena[parent].left = node;
+			} else {
+				_arena[parent].right = node;
+			}
+			_insert_fix_up(node);
+			++_size;
+			return ft::make_pair(iterator(node, &_arena), true);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last,
+					typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = 0) {
+			while (first != last) {
+				insert(*first);
+				++first;
+			}
+		}
+
+		void erase(iterator pos) {
+			if (pos._index != nil) {
+				_erase_helper(pos._index);
+			}
+		}
+
+		void erase(iterator first, iterator last) {
+			while (first != last) {
+				erase(first++);
+			}
+		}
+
+		size_type erase(const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				return 0;
+			}
+			erase(it);
+			return 1;
+		}
+
+		size_type count(const key_type& key) const {
+			if (find(key) != end()) {
+				return 1;
+			}
+			return 0;
+		}
+
+		iterator find(const key_type& key) {
+			index_type current = _arena.root;
+			while (current != nil) {
+				const node_type& node = _arena[current];
+				bool go_right = _comp(_key_of(node.data()), key);
+				if (!go_right && !_comp(key, _key_of(node.data()))) {
+					break ;
+				}
+				current = node.child(go_right);
+			}
+			return iterator(current, &_arena);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return const_cast<rb_arena_tree*>(this)->find(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			return ft::make_pair<iterator, iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			return ft::make_pair<const_iterator, const_iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		iterator lower_bound(const key_type& key) {
+			index_type current = _arena.root;
+			index_type result = nil;
+			while (current != nil) {
+				if (_comp(_key(current), key)) {
+					current = _arena[current].right;
+				} else {
+					result = current;
+					current = _arena[current].left;
+				}
+			}
+			return iterator(result, &_arena);
+		}
+
+		const_iterator lower_bound(const key_type& key) const {
+			return const_cast<rb_arena_tree*>(this)->lower_bound(key);
+		}
+
+		iterator upper_bound(const key_type& key) {
+			index_type current = _arena.root;
+			index_type result = nil;
+			while (current != nil) {
+				if (_comp(key, _key(current))) {
+					result = current;
+					current = _arena[current].left;
+				} else {
+					current = _arena[current].right;
+				}
+			}
+			return iterator(result, &_arena);
+		}
+
+		const_iterator upper_bound(const key_type& key) const {
+			return const_cast<rb_arena_tree*>(this)->upper_bound(key);
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+	private:
+		const key_type& _key(index_type node) const {
+			return _key_of(_arena[node].data());
+		}
+
+		index_type _first(void) const {
+			if (_arena.root == nil) {
+				return nil;
+			}
+			return _arena.minimum(_arena.root);
+		}
+
+		bool _is_red(index_type node) const {
+			return node != nil && _arena[node].color() == RED;
+		}
+
+		index_type _create_node(const value_type& value) {
+			index_type index = _arena.allocate();
+			try {
+				_arena[index].construct(value);
+			} catch (...) {
+				_arena.deallocate(index);
+				throw;
+			}
+			return index;
+		}
+
+		void _delete_node(index_type node) {
+			_arena[node].destroy();
+			_arena.deallocate(node);
+		}
+
+		void _replace_child(index_type parent, index_type old_child, index_type new_child) {
+			if (parent == nil) {
+				_arena.root = new_child;
+			} else if (_arena[parent].left == old_child) {
+				_arena[parent].left = new_child;
+			} else {
+				_arena[parent].right = new_child;
+			}
+		}
+
+		void _rotate_left(index_type x) {
+			index_type y = _arena[x].right;
+			_arena[x].right = _arena[y].left;
+			if (_arena[y].left != nil) {
+				_arena[_arena[y].left].set_parent(x);
+			}
+			_arena[y].set_parent(_arena[x].parent());
+			_replace_child(_arena[x].parent(), x, y);
+			_arena[y].left = x;
+			_arena[x].set_parent(y);
+		}
+
+		void _rotate_right(index_type x) {
+			index_type y = _arena[x].left;
+			_arena[x].left = _arena[y].right;
+			if (_arena[y].right != nil) {
+				_arena[_arena[y].right].set_parent(x);
+			}
+			_arena[y].set_parent(_arena[x].parent());
+			_replace_child(_arena[x].parent(), x, y);
+			_arena[y].right = x;
+			_arena[x].set_parent(y);
+		}
+
+		void _insert_fix_up(index_type node) {
+			while (node != _arena.root && _is_red(_arena[node].parent())) {
+				index_type parent = _arena[node].parent();
+				index_type grandparent = _arena[parent].parent();
+				if (parent == _arena[grandparent].left) {
+					index_type uncle = _arena[grandparent].right;
+					if (_is_red(uncle)) {
+						_arena[parent].set_color(BLACK);
+						_arena[uncle].set_color(BLACK);
+						_arena[grandparent].set_color(RED);
+						node = grandparent;
+						continue ;
+					}
+					if (node == _arena[parent].right) {
+						node = parent;
+						_rotate_left(node);
+						parent = _arena[node].parent();
+					}
+					_arena[parent].set_color(BLACK);
+					_arena[grandparent].set_color(RED);
+					_rotate_right(grandparent);
+				} else {
+					index_type uncle = _arena[grandparent].left;
+					if (_is_red(uncle)) {
+						_arena[parent].set_color(BLACK);
+						_arena[uncle].set_color(BLACK);
+						_arena[grandparent].set_color(RED);
+						node = grandparent;
+						continue ;
+					}
+					if (node == _arena[parent].left) {
+						node = parent;
+						_rotate_right(node);
+						parent = _arena[node].parent();
+					}
+					_arena[parent].set_color(BLACK);
+					_arena[grandparent].set_color(RED);
+					_rotate_left(grandparent);
+				}
+			}
+			_arena[_arena.root].set_color(BLACK);
+		}
+
+		// Without a sentinel node the child replacing the removed one may be
+		// nil, so its parent is tracked separately during the fix-up.
+		void _erase_helper(index_type z) {
+			index_type y = z;
+			index_type x;
+			index_type x_parent;
+			if (_arena[z].left == nil) {
+				x = _arena[z].right;
+			} else if (_arena[z].right == nil) {
+				x = _arena[z].left;
+			} else {
+				y = _arena.minimum(_arena[z].right);
+				x = _arena[y].right;
+			}
+			if (y != z) {
+				_arena[_arena[z].left].set_parent(y);
+				_arena[y].left = _arena[z].left;
+				if (y != _arena[z].right) {
+					x_parent = _arena[y].parent();
+					if (x != nil) {
+						_arena[x].set_parent(x_parent);
+					}
+					_arena[x_parent].left = x;
+					_arena[y].right = _arena[z].right;
+					_arena[_arena[z].right].set_parent(y);
+				} else {
+					x_parent = y;
+				}
+				_replace_child(_arena[z].parent(), z, y);
+				_arena[y].set_parent(_arena[z].parent());
+				ft::color y_color = _arena[y].color();
+				_arena[y].set_color(_arena[z].color());
+				_arena[z].set_color(y_color);
+			} else {
+				x_parent = _arena[z].parent();
+				if (x != nil) {
+					_arena[x].set_parent(x_parent);
+				}
+				_replace_child(x_parent, z, x);
+			}
+			if (_arena[z].color() == BLACK) {
+				_delete_fix_up(x, x_parent);
+			}
+			_delete_node(z);
+			--_size;
+		}
+
+		void _delete_fix_up(index_type x, index_type x_parent) {
+			while (x != _arena.root && !_is_red(x)) {
+				if (x == _arena[x_parent].left) {
+					index_type w = _arena[x_parent].right;
+					if (_is_red(w)) {
+						_arena[w].set_color(BLACK);
+						_arena[x_parent].set_color(RED);
+						_rotate_left(x_parent);
+						w = _arena[x_parent].right;
+					}
+					if (!_is_red(_arena[w].left) && !_is_red(_arena[w].right)) {
+						_arena[w].set_color(RED);
+						x = x_parent;
+						x_parent = _arena[x].parent();
+						continue ;
+					}
+					if (!_is_red(_arena[w].right)) {
+						_arena[_arena[w].left].set_color(BLACK);
+						_arena[w].set_color(RED);
+						_rotate_right(w);
+						w = _arena[x_parent].right;
+					}
+					_arena[w].set_color(_arena[x_parent].color());
+					_arena[x_parent].set_color(BLACK);
+					_arena[_arena[w].right].set_color(BLACK);
+					_rotate_left(x_parent);
+				} else {
+					index_type w = _arena[x_parent].left;
+					if (_is_red(w)) {
+						_arena[w].set_color(BLACK);
+						_arena[x_parent].set_color(RED);
+						_rotate_right(x_parent);
+						w = _arena[x_parent].left;
+					}
+					if (!_is_red(_arena[w].right) && !_is_red(_arena[w].left)) {
+						_arena[w].set_color(RED);
+						x = x_parent;
+						x_parent = _arena[x].parent();
+						continue ;
+					}
+					if (!_is_red(_arena[w].left)) {
+						_arena[_arena[w].right].set_color(BLACK);
+						_arena[w].set_color(RED);
+						_rotate_left(w);
+						w = _arena[x_parent].left;
+					}
+					_arena[w].set_color(_arena[x_parent].color());
+					_arena[x_parent].set_color(BLACK);
+					_arena[_arena[w].left].set_color(BLACK);
+					_rotate_right(x_parent);
+				}
+				x = _arena.root;
+			}
+			if (x != nil) {
+				_arena[x].set_color(BLACK);
+			}
+		}
+	};
+
+	// Spellings of rb_arena_tree for the Tree parameter of ft::map and ft::set.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	struct rb_arena_map_tree {
+		typedef rb_arena_tree<Key, pair<const Key, T>, select_first<pair<const Key, T> >,
+								Compare, Allocator>								type;
+	};
+
+	template<class Key, class Compare = less<Key>, class Allocator = std::allocator<Key> >
+	struct rb_arena_set_tree {
+		typedef rb_arena_tree<Key, Key, identity<Key>, Compare, Allocator>		type;
+	};
+}
+
+#endif
@@ -0,0 +1,1654 @@
+#ifndef RB_TREE_HPP
+# define RB_TREE_HPP
+
+# include <cstddef>
+# include <memory>
+# include <iostream>
+# include <stdexcept>
+# include "../utils/pair.hpp"
+# include "rbt_node.hpp"
+# include "rbt_node_handle.hpp"
+# include "rbt_bidirectional_iterator.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/type_traits.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	// What at() and operator[] of a tree whose Update reads mapped values
+	// return instead of a reference: assigning through it goes through the
+	// tree, which brings the metadata above the element up to date. Reads
+	// convert to a const reference.
+	template<class Tree>
+	class rbt_mapped_proxy {
+	public:
+		typedef typename Tree::mapped_type		mapped_type;
+		typedef typename Tree::pointer			node_ptr;
+
+	private:
+		Tree*									_tree;
+		node_ptr								_node;
+
+	public:
+		rbt_mapped_proxy(Tree* tree, node_ptr node) : _tree(tree), _node(node) {}
+
+		rbt_mapped_proxy& operator=(const mapped_type& value) {
+			_tree->_assign_mapped(_node, value);
+			return *this;
+		}
+
+		rbt_mapped_proxy& operator=(const rbt_mapped_proxy& other) {
+			return *this = other.get();
+		}
+
+		operator const mapped_type&() const {
+			return get();
+		}
+
+		const mapped_type& get(void) const {
+			return _node->data.second;
+		}
+	};
+
+	template<class Tree, class Mapped, bool Proxy>
+	struct rbt_mapped_reference {
+		typedef Mapped&							type;
+	};
+
+	template<class Tree, class Mapped>
+	struct rbt_mapped_reference<Tree, Mapped, true> {
+		typedef rbt_mapped_proxy<Tree>			type;
+	};
+
+	// Red-black tree behind ft::map, ft::set and their multi and interval
+	// variants. KeyOfValue gives the key of an element: select_first for
+	// the pairs of a map, identity for a set. Update keeps per-node
+	// metadata (subtree sizes, aggregates) in step with the shape.
+	template<class Key, class Value, class KeyOfValue, class Compare = less<Key>,
+			class Allocator = std::allocator<Value>, class Update = rbt_no_update>
+	class red_black_tree {
+	public:
+		typedef Key																key_type;
+		typedef Value															value_type;
+		typedef typename rbt_handle_types<Value>::mapped_type					mapped_type;
+		typedef Compare															key_compare;
+		typedef	rbt_node<value_type, Update>									node_type;
+		typedef typename Update::metadata_type									metadata_type;
+		typedef	node_type*														pointer;
+		typedef	const node_type*												const_pointer;
+		typedef	node_type&														reference;
+		typedef	const node_type&												const_reference;
+		typedef rbt_node_base::base_ptr											base_ptr;
+		typedef typename Allocator::template rebind<node_type>::other			allocator_type;
+		typedef std::size_t														size_type;
+		typedef std::ptrdiff_t													difference_type;
+		typedef ft::rbt_bidirectional_iterator<node_type>						iterator;
+		typedef ft::rbt_bidirectional_iterator<const node_type>					const_iterator;
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+		typedef rbt_node_handle<node_type, allocator_type>						node_handle;
+		typedef rbt_insert_return<iterator, node_handle>						insert_return_type;
+		typedef typename rbt_mapped_reference<red_black_tree, mapped_type,
+											Update::reads_mapped>::type			mapped_reference;
+
+	private:
+		// The header is end(). Its parent link holds the root, whose parent
+		// link points back at it, and its children point at itself, which
+		// is how iterators tell it from an element; so --end() finds the
+		// last element from the header alone. Leaves are the shared
+		// rbt_nil(), which is never written: subtrees change trees (split,
+		// join) without relinking their leaves, and while detached from any
+		// tree have nil parents. The size is kept exact by every operation,
+		// split and the set operations included.
+		rbt_node_base		_header;
+		base_ptr			_nil;
+		key_compare			_comp;
+		size_type			_size;
+		allocator_type		_alloc;
+
+		// Range erases longer than this are cut out with split and join.
+		static const size_type	_erase_range_threshold = 128;
+		// Descents find_batch() keeps in flight at once.
+		static const size_type	_batch_width = 32;
+
+		// Above this ratio of the larger size to the smaller a set operation
+		// splits and joins; below it a linear merge is cheaper.
+		static const size_type	_merge_ratio = 8;
+
+	public:
+		explicit red_black_tree(const key_compare& comp = key_compare(),
+								const allocator_type& alloc = allocator_type()) :	_header(), _nil(rbt_nil()),
+																					_comp(comp), _size(0), _alloc(alloc) {
+			_init_header();
+		}
+
+		template<class InputIt>
+		red_black_tree(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+						const allocator_type& alloc = allocator_type()) :	_header(), _nil(rbt_nil()),
+																			_comp(comp), _size(0), _alloc(alloc) {
+			_init_header();
+			insert(first, last);
+		}
+
+		red_black_tree(const red_black_tree& other) :	_header(), _nil(rbt_nil()),
+														_comp(other._comp), _size(0), _alloc(other._alloc) {
+			_init_header();
+			_copy(other);
+		}
+
+		virtual ~red_black_tree(void) {
+			clear();
+		}
+
+		red_black_tree& operator=(const red_black_tree& other) {
+			if (this == &other) {
+				return *this;
+			}
+			clear();
+			_alloc = other._alloc;
+			_comp = other._comp;
+			_copy(other);
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		// Map elements. When Update aggregates mapped values these return
+		// an rbt_mapped_proxy, so a write cannot leave aggregates stale.
+		mapped_reference at(const key_type& key) {
+			pointer pos = _search_key(key);
+			if (pos) {
+				return _mapped_ref(pos, ft::integral_constant<bool, Update::reads_mapped>());
+			} else {
+				throw std::out_of_range("Out of range");
+			}
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			pointer pos = _search_key(key);
+			if (pos) {
+				return pos->data.second;
+			} else {
+				throw std::out_of_range("Out of range");
+			}
+		}
+
+		mapped_reference operator[](const key_type& key) {
+			pointer pos = _search_key(key);
+			if (!pos) {
+				insert(ft::make_pair<key_type, mapped_type>(key, mapped_type()));
+				pos = _search_key(key);
+			}
+			return _mapped_ref(pos, ft::integral_constant<bool, Update::reads_mapped>());
+		}
+
+		iterator begin(void) {
+			base_ptr tmp = _root();
+			while (tmp != _nil && tmp->left != _nil) {
+				tmp = tmp->left;
+			}
+			return iterator(_position(tmp));
+		}
+
+		const_iterator begin(void) const {
+			base_ptr tmp = _root();
+			while (tmp != _nil && tmp->left != _nil) {
+				tmp = tmp->left;
+			}
+			return const_iterator(_position(tmp));
+		}
+
+		iterator end(void) {
+			return iterator(_end_node());
+		}
+
+		const_iterator end(void) const {
+			return const_iterator(_end_node());
+		}
+
+		reverse_iterator rbegin(void) {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin(void) const {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend(void) {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend(void) const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool empty(void) const {
+			return _root() == _nil;
+		}
+
+		size_type size(void) const {
+			return _size;
+		}
+
+		size_type max_size(void) const {
+			return _alloc.max_size();
+		}
+
+		void clear(void) {
+			_clear_help(_root());
+			_set_root(_nil);
+			_size = 0;
+		}
+
+		// Moves the elements not less than key into right, whose previous
+		// contents are destroyed: the path to key is cut and the subtrees
+		// hanging off it are joined back into two trees. O(log n) when the
+		// nodes keep subtree sizes; otherwise size() needs the smaller
+		// part counted as well, O(log n + k) for its k elements.
+		void split(const key_type& key, red_black_tree& right) {
+			if (&right == this) {
+				return ;
+			}
+			right.clear();
+			base_ptr left_root;
+			base_ptr right_root;
+			size_type left_height;
+			size_type right_height;
+			size_type total = _size;
+			_split(_root(), _black_height(_root()), key, left_root, left_height, right_root, right_height);
+			_set_root(left_root);
+			right._set_root(right_root);
+			_split_sizes(right, total, ft::integral_constant<bool, Update::ranked>());
+		}
+
+		// Moves every element of other into this tree and empties other. When
+		// the key ranges do not interleave the trees are linked in O(log n);
+		// otherwise other's elements are inserted one by one.
+		void join(red_black_tree& other) {
+			if (&other == this || other._root() == _nil) {
+				return ;
+			}
+			if (_root() == _nil) {
+				_set_root(other._root());
+				_size = other._size;
+				other._set_root(_nil);
+				other.clear();
+				return ;
+			}
+			bool before = _comp(_key(_maximum(_root())), _key(_minimum(other._root())));
+			if (!before && !_comp(_key(_maximum(other._root())), _key(_minimum(_root())))) {
+				insert(other.begin(), other.end());
+				other.clear();
+				return ;
+			}
+			size_type total = _size + other._size;
+			// The first element of the upper tree becomes the join point.
+			red_black_tree& upper = before ? other : *this;
+			base_ptr mid = _minimum(upper._root());
+			upper._unlink(mid);
+			base_ptr lower_root = before ? _root() : other._root();
+			base_ptr upper_root = upper._root();
+			size_type height;
+			_set_root(_join(lower_root, _black_height(lower_root), mid, upper_root, _black_height(upper_root), height));
+			_size = total;
+			other._set_root(_nil);
+			other.clear();
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			iterator it = find(KeyOfValue()(value));
+			if (it != end()) {
+				return ft::make_pair(it, false);
+			}
+			pointer new_node = _create_node(value);
+			_link(new_node);
+			return ft::make_pair(iterator(_position(new_node)), true);
+		}
+
+		// Links the node of handle into the tree unless its key is already
+		// present, in which case the handle comes back in the result.
+		insert_return_type insert(node_handle handle) {
+			insert_return_type result;
+			result.inserted = false;
+			if (handle.empty()) {
+				result.position = end();
+				return result;
+			}
+			pointer node = handle._release();
+			result.position = find(_key(node));
+			if (result.position != end()) {
+				result.node = node_handle(node, _alloc);
+				return result;
+			}
+			_link(node);
+			result.position = iterator(_position(node));
+			result.inserted = true;
+			return result;
+		}
+
+		// Unlinks the element at pos and hands its node over, neither
+		// copying the element nor freeing memory.
+		node_handle extract(iterator pos) {
+			if (pos == end()) {
+				return node_handle();
+			}
+			_unlink(pos._ptr);
+			return node_handle(static_cast<pointer>(pos._ptr), _alloc);
+		}
+
+		node_handle extract(const key_type& key) {
+			return extract(find(key));
+		}
+
+		// Moves into this tree the nodes of other whose keys are not here
+		// yet; the rest stay in other. No element is copied or allocated.
+		void merge(red_black_tree& other) {
+			if (&other == this) {
+				return ;
+			}
+			iterator it = other.begin();
+			while (it != other.end()) {
+				base_ptr node = it._ptr;
+				++it;
+				if (_search_key(_key(node))) {
+					continue ;
+				}
+				other._unlink(node);
+				_link(static_cast<pointer>(node));
+			}
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			(void)hint;
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last,
+					typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = 0) {
+			while (first != last) {
+				insert(*first);
+				++first;
+			}
+		}
+
+		// Equal keys, for ft::multimap and ft::multiset. The insert descent
+		// sends a key equal to a node's to the right, so equal elements
+		// keep their insertion order.
+		iterator insert_multi(const value_type& value) {
+			pointer new_node = _create_node(value);
+			_link(new_node);
+			return iterator(_position(new_node));
+		}
+
+		template<class InputIt>
+		void insert_multi(InputIt first, InputIt last) {
+			for (; first != last; ++first) {
+				insert_multi(*first);
+			}
+		}
+
+		void erase(iterator pos) {
+			if (pos != end()) {
+				_erase_helper(pos._ptr);
+				--_size;
+			}
+		}
+
+		// The first elements of a range go one by one; past a threshold the
+		// rest is cut out of the tree whole, so a sweep over the oldest keys
+		// does not pay for a rebalance per element. Iterators outside the
+		// range stay valid.
+		void erase(iterator first, iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return ;
+			}
+			for (size_type count = 0; first != last; ++count) {
+				if (count == _erase_range_threshold) {
+					_erase_range(first, last);
+					return ;
+				}
+				erase(first++);
+			}
+		}
+
+		size_type erase(const key_type& key) {
+			iterator it = find(key);
+			if (it == end()) {
+				return 0;
+			}
+			erase(it);
+			return 1;
+		}
+
+		// Lookups take any key the comparator accepts. ft::map and ft::set
+		// pass keys of another type only when the comparator is transparent.
+		template<class K>
+		size_type count(const K& key) const {
+			if (find(key) != end()) {
+				return 1;
+			}
+			return 0;
+		}
+
+		template<class K>
+		iterator find(const K& key) {
+			pointer node = _search_key(key);
+			if (!node) {
+				return end();
+			}
+			return iterator(_position(node));
+		}
+
+		template<class K>
+		const_iterator find(const K& key) const {
+			pointer node = _search_key(key);
+			if (!node) {
+				return end();
+			}
+			return const_iterator(_position(node));
+		}
+
+		// Keys are unique: the range past lower_bound is one element or none.
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K& key) {
+			iterator first = lower_bound(key);
+			iterator last = first;
+			if (last != end() && !_comp(key, _key(last._ptr))) {
+				++last;
+			}
+			return ft::make_pair<iterator, iterator> (first, last);
+		}
+
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+			const_iterator first = lower_bound(key);
+			const_iterator last = first;
+			if (last != end() && !_comp(key, _key(last._ptr))) {
+				++last;
+			}
+			return ft::make_pair<const_iterator, const_iterator> (first, last);
+		}
+
+		template<class K>
+		iterator lower_bound(const K& key) {
+			return iterator(_position(_lower_bound(key)));
+		}
+
+		template<class K>
+		const_iterator lower_bound(const K& key) const {
+			return const_iterator(_position(_lower_bound(key)));
+		}
+
+		template<class K>
+		iterator upper_bound(const K& key) {
+			return iterator(_position(_upper_bound(key)));
+		}
+
+		template<class K>
+		const_iterator upper_bound(const K& key) const {
+			return const_iterator(_position(_upper_bound(key)));
+		}
+
+		// Lookups over equal keys. count_multi() is O(log n) when the nodes
+		// keep subtree sizes and O(log n + count) otherwise.
+		template<class K>
+		size_type count_multi(const K& key) const {
+			return static_cast<size_type>(ft::distance(lower_bound(key), upper_bound(key)));
+		}
+
+		template<class K>
+		ft::pair<iterator, iterator> equal_range_multi(const K& key) {
+			return ft::make_pair<iterator, iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range_multi(const K& key) const {
+			return ft::make_pair<const_iterator, const_iterator> (lower_bound(key), upper_bound(key));
+		}
+
+		template<class K>
+		size_type erase_multi(const K& key) {
+			iterator first = lower_bound(key);
+			iterator last = upper_bound(key);
+			size_type count = static_cast<size_type>(ft::distance(first, last));
+			erase(first, last);
+			return count;
+		}
+
+		// Looks up every key in [first, last) and writes an iterator to each
+		// to out, end() for a missing key, in the order of the keys. Groups
+		// of descents go down one level at a time with the next nodes
+		// prefetched, so their cache misses overlap instead of queuing up.
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+			base_ptr found[_batch_width];
+			while (first != last) {
+				size_type count = _find_group(first, last, found);
+				for (size_type i = 0; i < count; ++i) {
+					*out++ = iterator(_position(found[i]));
+				}
+			}
+			return out;
+		}
+
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+			base_ptr found[_batch_width];
+			while (first != last) {
+				size_type count = _find_group(first, last, found);
+				for (size_type i = 0; i < count; ++i) {
+					*out++ = const_iterator(_position(found[i]));
+				}
+			}
+			return out;
+		}
+
+		// Element at position k in key order, or end() past the last one.
+		// Requires rbt_order_statistics, as does rank().
+		iterator nth(size_type k) {
+			return iterator(_position(_select(k)));
+		}
+
+		const_iterator nth(size_type k) const {
+			return const_iterator(_position(_select(k)));
+		}
+
+		// Number of elements less than key.
+		size_type rank(const key_type& key) const {
+			base_ptr node = _root();
+			size_type rank = 0;
+			while (node != _nil) {
+				if (_comp(_key(node), key)) {
+					rank += _subtree_size(node->left) + 1;
+					node = node->right;
+				} else {
+					node = node->left;
+				}
+			}
+			return rank;
+		}
+
+		// Elements with keys in [first, last) combined in key order by the
+		// monoid of an rbt_monoid_update policy, in O(log n).
+		metadata_type aggregate(const key_type& first, const key_type& last) const {
+			typename Update::monoid_type op;
+			base_ptr split = _root();
+			while (split != _nil) {
+				if (_comp(_key(split), first)) {
+					split = split->right;
+				} else if (!_comp(_key(split), last)) {
+					split = split->left;
+				} else {
+					break ;
+				}
+			}
+			if (split == _nil) {
+				return op.identity();
+			}
+			metadata_type left = op.identity();
+			for (base_ptr node = split->left; node != _nil; ) {
+				if (_comp(_key(node), first)) {
+					node = node->right;
+				} else {
+					left = op(op(_own_value(node), _subtree_value(node->right)), left);
+					node = node->left;
+				}
+			}
+			metadata_type right = op.identity();
+			for (base_ptr node = split->right; node != _nil; ) {
+				if (_comp(_key(node), last)) {
+					right = op(right, op(_subtree_value(node->left), _own_value(node)));
+					node = node->right;
+				} else {
+					node = node->left;
+				}
+			}
+			return op(op(left, _own_value(split)), right);
+		}
+
+		// Writes to out, in key order, a const_iterator to each element that
+		// filter.match() accepts. Subtrees whose root metadata fails
+		// filter.subtree() are skipped and the walk ends at the first element
+		// filter.past() puts after every match, so the cost follows the
+		// number of matches rather than the size of the tree.
+		template<class Filter, class OutputIterator>
+		OutputIterator search(const Filter& filter, OutputIterator out) const {
+			_search(_root(), filter, out);
+			return out;
+		}
+
+		// Assigns through the tree so Update metadata follows the new value.
+		ft::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& obj) {
+			pointer node = _search_key(key);
+			if (!node) {
+				return insert(value_type(key, obj));
+			}
+			_assign_mapped(node, obj);
+			return ft::make_pair(iterator(_position(node)), false);
+		}
+
+		// Set algebra that consumes other: this tree becomes the union,
+		// intersection or difference and other is left empty. Nodes are
+		// relinked, never copied, so iterators to surviving elements of this
+		// tree stay valid; of two equivalent elements this tree's is kept.
+		// Trees of very different sizes split the larger one around the
+		// smaller one's keys and join the pieces, O(m log n); trees of similar
+		// size are merged in order and rebuilt balanced in O(n + m).
+		void unite(red_black_tree& other) {
+			_set_operation(other, _unite);
+		}
+
+		void intersect(red_black_tree& other) {
+			_set_operation(other, _intersect);
+		}
+
+		void subtract(red_black_tree& other) {
+			_set_operation(other, _subtract);
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+	private:
+		static const key_type& _key(base_ptr node) {
+			return KeyOfValue()(static_cast<pointer>(node)->data);
+		}
+
+		void _init_header(void) {
+			_header.set_parent(_nil);
+			_header.left = &_header;
+			_header.right = &_header;
+		}
+
+		base_ptr _end_node(void) const {
+			return const_cast<base_ptr>(&_header);
+		}
+
+		base_ptr _root(void) const {
+			return _header.parent();
+		}
+
+		// Hangs node under the header. Also used as scratch space while
+		// split and join rebuild detached subtrees, whose roots the header
+		// holds for the rotations.
+		void _set_root(base_ptr node) {
+			_header.set_parent(node);
+			if (node != _nil) {
+				node->set_parent(_end_node());
+			}
+		}
+
+		// A node with no parent in the tree or subtree it is in.
+		bool _is_root(base_ptr node) const {
+			return node->parent() == _nil || node->parent() == _end_node();
+		}
+
+		// The searches below return nil for nothing found; iterators want
+		// end().
+		base_ptr _position(base_ptr node) const {
+			return node == _nil ? _end_node() : node;
+		}
+
+		void _clear_help(base_ptr node) {
+			if (node == _nil) {
+				return ;
+			}
+			_clear_help(node->left);
+			_clear_help(node->right);
+			_delete_node(static_cast<pointer>(node));
+			--_size;
+		}
+
+		// Sizes of the two trees a split of total elements left: read off
+		// the root when nodes keep subtree sizes, otherwise by walking both
+		// trees at once until the smaller ends, O(min(left, right)).
+		void _split_sizes(red_black_tree& right, size_type total, ft::true_type) {
+			_size = _subtree_size(_root());
+			right._size = total - _size;
+		}
+
+		void _split_sizes(red_black_tree& right, size_type total, ft::false_type) {
+			iterator mine = begin();
+			iterator theirs = right.begin();
+			size_type n = 0;
+			while (mine != end() && theirs != right.end()) {
+				++mine;
+				++theirs;
+				++n;
+			}
+			if (mine == end()) {
+				_size = n;
+				right._size = total - n;
+			} else {
+				right._size = n;
+				_size = total - n;
+			}
+		}
+
+		base_ptr _minimum(base_ptr node) const {
+			while (node->left != _nil) {
+				node = node->left;
+			}
+			return node;
+		}
+
+		base_ptr _maximum(base_ptr node) const {
+			while (node->right != _nil) {
+				node = node->right;
+			}
+			return node;
+		}
+
+		// Black nodes on every path from node down to a leaf.
+		size_type _black_height(base_ptr node) const {
+			size_type height = 0;
+			for (; node != _nil; node = node->left) {
+				if (node->color() == BLACK) {
+					++height;
+				}
+			}
+			return height;
+		}
+
+		// Detaches a subtree root as a tree of its own. A red root is made
+		// black, which keeps it valid and adds one to its black height.
+		base_ptr _detach(base_ptr node, size_type& height) {
+			if (node != _nil) {
+				node->set_parent(_nil);
+				if (node->color() == RED) {
+					node->set_color(BLACK);
+					++height;
+				}
+			}
+			return node;
+		}
+
+		// Links the trees rooted at left and right under mid, every key in
+		// left being less than mid's and every key in right greater. mid is
+		// hung off the spine of the taller tree at the shorter one's black
+		// height and the insert fix-up repairs the colors, so the cost is
+		// O(|left_height - right_height| + 1). Returns the new root; its black
+		// height goes to height.
+		base_ptr _join(base_ptr left, size_type left_height, base_ptr mid,
+						base_ptr right, size_type right_height, size_type& height) {
+			mid->left = left;
+			mid->right = right;
+			if (left != _nil) {
+				left->set_parent(mid);
+			}
+			if (right != _nil) {
+				right->set_parent(mid);
+			}
+			if (left_height == right_height) {
+				mid->set_parent(_nil);
+				mid->set_color(BLACK);
+				_update(mid);
+				height = left_height + 1;
+				return mid;
+			}
+			bool left_taller = left_height > right_height;
+			base_ptr root = left_taller ? left : right;
+			base_ptr parent = _nil;
+			base_ptr node = root;
+			size_type node_height = left_taller ? left_height : right_height;
+			size_type target = left_taller ? right_height : left_height;
+			while (node->color() == RED || node_height > target) {
+				if (node->color() == BLACK) {
+					--node_height;
+				}
+				parent = node;
+				node = left_taller ? node->right : node->left;
+			}
+			if (left_taller) {
+				mid->left = node;
+				parent->right = mid;
+			} else {
+				mid->right = node;
+				parent->left = mid;
+			}
+			if (node != _nil) {
+				node->set_parent(mid);
+			}
+			mid->set_parent(parent);
+			mid->set_color(RED);
+			root->set_parent(_nil);
+			_set_root(root);
+			_update_path(mid);
+			height = left_taller ? left_height : right_height;
+			if (_insert_fix_up(mid)) {
+				++height;
+			}
+			return _root();
+		}
+
+		// Splits the tree rooted at node, of black height node_height, into
+		// the keys less than key and the rest. Given equal, an element
+		// equivalent to key is left out of both and returned there instead.
+		void _split(base_ptr node, size_type node_height, const key_type& key,
+					base_ptr& left, size_type& left_height, base_ptr& right, size_type& right_height,
+					base_ptr* equal = 0) {
+			if (node == _nil) {
+				left = _nil;
+				right = _nil;
+				left_height = 0;
+				right_height = 0;
+				return ;
+			}
+			size_type child_height = node_height - (node->color() == BLACK ? 1 : 0);
+			size_type left_child_height = child_height;
+			size_type right_child_height = child_height;
+			base_ptr left_child = _detach(node->left, left_child_height);
+			base_ptr right_child = _detach(node->right, right_child_height);
+			if (equal && !_comp(_key(node), key) && !_comp(key, _key(node))) {
+				left = left_child;
+				left_height = left_child_height;
+				right = right_child;
+				right_height = right_child_height;
+				*equal = node;
+			} else if (_comp(_key(node), key)) {
+				base_ptr rest;
+				size_type rest_height;
+				_split(right_child, right_child_height, key, rest, rest_height, right, right_height, equal);
+				left = _join(left_child, left_child_height, node, rest, rest_height, left_height);
+			} else {
+				base_ptr rest;
+				size_type rest_height;
+				_split(left_child, left_child_height, key, left, left_height, rest, rest_height, equal);
+				right = _join(rest, rest_height, node, right_child, right_child_height, right_height);
+			}
+		}
+
+		// As _split, but cuts just before the element target, which is in
+		// the tree: equal keys on both sides of the cut, as in a multi
+		// tree, end up where their positions put them.
+		void _split_before(base_ptr node, size_type node_height, base_ptr target,
+							base_ptr& left, size_type& left_height, base_ptr& right, size_type& right_height) {
+			if (node == _nil) {
+				left = _nil;
+				right = _nil;
+				left_height = 0;
+				right_height = 0;
+				return ;
+			}
+			int side = _side_of(node, target);
+			size_type child_height = node_height - (node->color() == BLACK ? 1 : 0);
+			size_type left_child_height = child_height;
+			size_type right_child_height = child_height;
+			base_ptr left_child = _detach(node->left, left_child_height);
+			base_ptr right_child = _detach(node->right, right_child_height);
+			base_ptr rest;
+			size_type rest_height;
+			if (side == 0) {
+				left = left_child;
+				left_height = left_child_height;
+				right = _join(_nil, 0, node, right_child, right_child_height, right_height);
+			} else if (side > 0) {
+				_split_before(right_child, right_child_height, target, rest, rest_height, right, right_height);
+				left = _join(left_child, left_child_height, node, rest, rest_height, left_height);
+			} else {
+				_split_before(left_child, left_child_height, target, left, left_height, rest, rest_height);
+				right = _join(rest, rest_height, node, right_child, right_child_height, right_height);
+			}
+		}
+
+		// Where target lies under node: 0 at node, -1 to the left, 1 to the
+		// right. Climbs from target, so the cost is its depth below node.
+		int _side_of(base_ptr node, base_ptr target) const {
+			if (target == node) {
+				return 0;
+			}
+			while (target->parent() != node) {
+				target = target->parent();
+			}
+			return target == node->left ? -1 : 1;
+		}
+
+		enum set_operation { _unite, _intersect, _subtract };
+
+		void _set_operation(red_black_tree& other, set_operation operation) {
+			if (&other == this) {
+				if (operation == _subtract) {
+					clear();
+				}
+				return ;
+			}
+			size_type mine = size();
+			size_type theirs = other.size();
+			size_type small = mine < theirs ? mine : theirs;
+			size_type large = mine < theirs ? theirs : mine;
+			if (small > large / _merge_ratio) {
+				_merge(other, operation);
+			} else {
+				size_type freed = 0;
+				if (operation == _unite) {
+					_set_root(_union(_root(), other._root(), freed));
+				} else if (operation == _intersect) {
+					_set_root(_intersection(_root(), other._root(), freed));
+				} else {
+					_set_root(_difference(_root(), other._root(), freed));
+				}
+				_size = mine + theirs - freed;
+			}
+			other._set_root(_nil);
+			other.clear();
+		}
+
+		// The split-and-join algorithms below work on detached subtrees
+		// (black roots, nil parents) and free the nodes they drop, adding
+		// their number to freed.
+		base_ptr _union(base_ptr a, base_ptr b, size_type& freed) {
+			if (a == _nil) {
+				return b;
+			}
+			if (b == _nil) {
+				return a;
+			}
+			base_ptr b_left;
+			base_ptr b_right;
+			base_ptr equal = _nil;
+			size_type height;
+			_split(b, _black_height(b), _key(a), b_left, height, b_right, height, &equal);
+			if (equal != _nil) {
+				_delete_node(static_cast<pointer>(equal));
+				++freed;
+			}
+			base_ptr a_left = _detach(a->left, height);
+			base_ptr a_right = _detach(a->right, height);
+			base_ptr left = _union(a_left, b_left, freed);
+			base_ptr right = _union(a_right, b_right, freed);
+			return _join(left, _black_height(left), a, right, _black_height(right), height);
+		}
+
+		base_ptr _intersection(base_ptr a, base_ptr b, size_type& freed) {
+			if (a == _nil || b == _nil) {
+				freed += _destroy(a);
+				freed += _destroy(b);
+				return _nil;
+			}
+			base_ptr b_left;
+			base_ptr b_right;
+			base_ptr equal = _nil;
+			size_type height;
+			_split(b, _black_height(b), _key(a), b_left, height, b_right, height, &equal);
+			base_ptr a_left = _detach(a->left, height);
+			base_ptr a_right = _detach(a->right, height);
+			base_ptr left = _intersection(a_left, b_left, freed);
+			base_ptr right = _intersection(a_right, b_right, freed);
+			++freed;
+			if (equal != _nil) {
+				_delete_node(static_cast<pointer>(equal));
+				return _join(left, _black_height(left), a, right, _black_height(right), height);
+			}
+			_delete_node(static_cast<pointer>(a));
+			return _join_without_pivot(left, right);
+		}
+
+		base_ptr _difference(base_ptr a, base_ptr b, size_type& freed) {
+			if (a == _nil || b == _nil) {
+				freed += _destroy(b);
+				return a;
+			}
+			base_ptr a_left;
+			base_ptr a_right;
+			base_ptr equal = _nil;
+			size_type height;
+			_split(a, _black_height(a), _key(b), a_left, height, a_right, height, &equal);
+			base_ptr b_left = _detach(b->left, height);
+			base_ptr b_right = _detach(b->right, height);
+			_delete_node(static_cast<pointer>(b));
+			++freed;
+			if (equal != _nil) {
+				_delete_node(static_cast<pointer>(equal));
+				++freed;
+			}
+			base_ptr left = _difference(a_left, b_left, freed);
+			base_ptr right = _difference(a_right, b_right, freed);
+			return _join_without_pivot(left, right);
+		}
+
+		// Linear path: both trees are walked in order into node arrays, the
+		// arrays merged and the kept nodes relinked as a balanced tree.
+		void _merge(red_black_tree& other, set_operation operation) {
+			ft::vector<base_ptr> mine;
+			ft::vector<base_ptr> theirs;
+			ft::vector<base_ptr> kept;
+			mine.reserve(size());
+			theirs.reserve(other.size());
+			_collect(_root(), mine);
+			_collect(other._root(), theirs);
+			kept.reserve(operation == _subtract ? mine.size() : mine.size() + theirs.size());
+			size_type i = 0;
+			size_type j = 0;
+			while (i < mine.size() || j < theirs.size()) {
+				if (j == theirs.size() || (i < mine.size() && _comp(_key(mine[i]), _key(theirs[j])))) {
+					if (operation != _intersect) {
+						kept.push_back(mine[i]);
+					} else {
+						_delete_node(static_cast<pointer>(mine[i]));
+					}
+					++i;
+				} else if (i == mine.size() || _comp(_key(theirs[j]), _key(mine[i]))) {
+					if (operation == _unite) {
+						kept.push_back(theirs[j]);
+					} else {
+						_delete_node(static_cast<pointer>(theirs[j]));
+					}
+					++j;
+				} else {
+					if (operation != _subtract) {
+						kept.push_back(mine[i]);
+					} else {
+						_delete_node(static_cast<pointer>(mine[i]));
+					}
+					_delete_node(static_cast<pointer>(theirs[j]));
+					++i;
+					++j;
+				}
+			}
+			_set_root(_build(kept, 0, kept.size(), 0, _red_depth(kept.size())));
+			_size = kept.size();
+		}
+
+		void _collect(base_ptr node, ft::vector<base_ptr>& nodes) const {
+			if (node == _nil) {
+				return ;
+			}
+			_collect(node->left, nodes);
+			nodes.push_back(node);
+			_collect(node->right, nodes);
+		}
+
+		// Depth whose nodes are colored red in a tree built by _build() from
+		// count nodes: the last level unless that level is full. Every path
+		// then holds the same number of black nodes.
+		static size_type _red_depth(size_type count) {
+			size_type levels = 0;
+			while ((static_cast<size_type>(1) << levels) - 1 < count) {
+				++levels;
+			}
+			if ((static_cast<size_type>(1) << levels) - 1 == count) {
+				return levels;
+			}
+			return levels - 1;
+		}
+
+		base_ptr _build(const ft::vector<base_ptr>& nodes, size_type first, size_type count,
+						size_type depth, size_type red_depth) {
+			if (count == 0) {
+				return _nil;
+			}
+			size_type middle = first + count / 2;
+			base_ptr node = nodes[middle];
+			node->left = _build(nodes, first, count / 2, depth + 1, red_depth);
+			node->right = _build(nodes, middle + 1, count - count / 2 - 1, depth + 1, red_depth);
+			if (node->left != _nil) {
+				node->left->set_parent(node);
+			}
+			if (node->right != _nil) {
+				node->right->set_parent(node);
+			}
+			node->set_color(depth == red_depth ? RED : BLACK);
+			_update(node);
+			return node;
+		}
+
+		// Links a detached node in at the place of its key, which must not
+		// be in the tree.
+		void _link(pointer node) {
+			node->set_color(RED);
+			node->set_parent(_nil);
+			node->left = _nil;
+			node->right = _nil;
+			if (_root() == _nil) {
+				node->set_color(BLACK);
+				_set_root(node);
+				_update(node);
+			} else {
+				_insert_helper(node, _root());
+			}
+			++_size;
+		}
+
+		// Joins two detached trees, taking the first element of right as
+		// the pivot.
+		base_ptr _join_without_pivot(base_ptr left, base_ptr right) {
+			if (left == _nil) {
+				return right;
+			}
+			if (right == _nil) {
+				return left;
+			}
+			base_ptr mid = _minimum(right);
+			_set_root(right);
+			_erase_helper(mid, false);
+			right = _root();
+			size_type height;
+			return _join(left, _black_height(left), mid, right, _black_height(right), height);
+		}
+
+		// Frees a detached subtree, returning how many nodes it held.
+		size_type _destroy(base_ptr node) {
+			if (node == _nil) {
+				return 0;
+			}
+			size_type count = _destroy(node->left) + _destroy(node->right) + 1;
+			_delete_node(static_cast<pointer>(node));
+			return count;
+		}
+
+		// Cuts [first, last) out with two splits at the positions of first
+		// and last, not their keys, frees it and joins what is left:
+		// O(k + log^2 n) for k erased elements.
+		void _erase_range(iterator first, iterator last) {
+			base_ptr lower;
+			base_ptr middle;
+			base_ptr upper = _nil;
+			size_type lower_height;
+			size_type middle_height;
+			size_type upper_height;
+			_split_before(_root(), _black_height(_root()), first._ptr, lower, lower_height, middle, middle_height);
+			if (last != end()) {
+				base_ptr rest = middle;
+				_split_before(rest, middle_height, last._ptr, middle, middle_height, upper, upper_height);
+			}
+			_size -= _destroy(middle);
+			_set_root(_join_without_pivot(lower, upper));
+		}
+
+		// Erases node from the tree without freeing it.
+		void _unlink(base_ptr node) {
+			_erase_helper(node, false);
+			--_size;
+		}
+
+		// First node not ordered before key, or _nil. Each level costs one
+		// comparison; equality is left to the caller, so keys need no ==.
+		template<class K>
+		base_ptr _lower_bound(const K& key) const {
+			base_ptr node = _root();
+			base_ptr bound = _nil;
+			while (node != _nil) {
+				if (_comp(_key(node), key)) {
+					node = node->right;
+				} else {
+					bound = node;
+					node = node->left;
+				}
+			}
+			return bound;
+		}
+
+		// First node ordered after key, or _nil.
+		template<class K>
+		base_ptr _upper_bound(const K& key) const {
+			base_ptr node = _root();
+			base_ptr bound = _nil;
+			while (node != _nil) {
+				if (_comp(key, _key(node))) {
+					bound = node;
+					node = node->left;
+				} else {
+					node = node->right;
+				}
+			}
+			return bound;
+		}
+
+		// Runs the _search_key() of up to _batch_width keys from first side
+		// by side, advancing first past them. found gets the node of each
+		// key or _nil; returns how many keys were taken.
+		template<class ForwardIt>
+		size_type _find_group(ForwardIt& first, ForwardIt last, base_ptr* found) const {
+			ForwardIt keys[_batch_width];
+			base_ptr nodes[_batch_width];
+			size_type count = 0;
+			for (; count < _batch_width && first != last; ++count, ++first) {
+				keys[count] = first;
+				nodes[count] = _root();
+				found[count] = _nil;
+			}
+			for (bool active = true; active; ) {
+				active = false;
+				for (size_type i = 0; i < count; ++i) {
+					base_ptr node = nodes[i];
+					if (node == _nil) {
+						continue;
+					}
+					if (_comp(_key(node), *keys[i])) {
+						node = node->right;
+					} else {
+						found[i] = node;
+						node = node->left;
+					}
+					if (node != _nil) {
+						rbt_prefetch(node);
+						active = true;
+					}
+					nodes[i] = node;
+				}
+			}
+			for (size_type i = 0; i < count; ++i) {
+				if (found[i] != _nil && _comp(*keys[i], _key(found[i]))) {
+					found[i] = _nil;
+				}
+			}
+			return count;
+		}
+
+		// The lower bound holds key unless key is ordered before it.
+		template<class K>
+		pointer _search_key(const K& key) const {
+			base_ptr node = _lower_bound(key);
+			if (node == _nil || _comp(key, _key(node))) {
+				return 0;
+			}
+			return static_cast<pointer>(node);
+		}
+
+		// Copies other node for node: same shape and colors, equal keys
+		// kept, no comparisons or rebalancing.
+		void _copy(const red_black_tree& other) {
+			_set_root(_clone(other._root(), _nil));
+			_size = other.size();
+		}
+
+		base_ptr _clone(base_ptr node, base_ptr parent) {
+			if (node == _nil) {
+				return _nil;
+			}
+			pointer copy = _create_node(static_cast<pointer>(node)->data);
+			copy->set_color(node->color());
+			copy->set_parent(parent);
+			copy->left = _clone(node->left, copy);
+			copy->right = _clone(node->right, copy);
+			_update(copy);
+			return copy;
+		}
+
+		template<class Filter, class OutputIterator>
+		bool _search(base_ptr node, const Filter& filter, OutputIterator& out) const {
+			if (node == _nil || !filter.subtree(static_cast<const_pointer>(node)->metadata)) {
+				return true;
+			}
+			if (!_search(node->left, filter, out)) {
+				return false;
+			}
+			const value_type& data = static_cast<const_pointer>(node)->data;
+			if (filter.past(data)) {
+				return false;
+			}
+			if (filter.match(data)) {
+				*out = const_iterator(_position(node));
+				++out;
+			}
+			return _search(node->right, filter, out);
+		}
+
+		pointer _create_node(const value_type& value) {
+			pointer node = _alloc.allocate(1);
+			_alloc.construct(node, node_type(value));
+			node->set_color(RED);
+			node->set_parent(_nil);
+			node->left = _nil;
+			node->right = _nil;
+			return node;
+		}
+
+		void _delete_node(pointer node) {
+			_alloc.destroy(node);
+			_alloc.deallocate(node, 1);
+		}
+
+		// Recomputes the Update metadata of node from its children.
+		void _update(base_ptr node) {
+			if (!Update::enabled) {
+				return ;
+			}
+			pointer left = (node->left != _nil) ? static_cast<pointer>(node->left) : 0;
+			pointer right = (node->right != _nil) ? static_cast<pointer>(node->right) : 0;
+			Update::update(*static_cast<pointer>(node), left, right, _comp);
+		}
+
+		void _update_path(base_ptr node) {
+			if (!Update::enabled) {
+				return ;
+			}
+			for (; node != _nil && node != _end_node(); node = node->parent()) {
+				_update(node);
+			}
+		}
+
+		friend class rbt_mapped_proxy<red_black_tree>;
+
+		void _assign_mapped(pointer node, const mapped_type& value) {
+			node->data.second = value;
+			_update_path(node);
+		}
+
+		mapped_reference _mapped_ref(pointer node, ft::false_type) {
+			return node->data.second;
+		}
+
+		mapped_reference _mapped_ref(pointer node, ft::true_type) {
+			return mapped_reference(this, node);
+		}
+
+		size_type _subtree_size(base_ptr node) const {
+			return node == _nil ? 0 : static_cast<const_pointer>(node)->metadata;
+		}
+
+		metadata_type _subtree_value(base_ptr node) const {
+			if (node == _nil) {
+				return typename Update::monoid_type().identity();
+			}
+			return static_cast<const_pointer>(node)->metadata;
+		}
+
+		metadata_type _own_value(base_ptr node) const {
+			return metadata_type(rbt_aggregated_value(static_cast<const_pointer>(node)->data));
+		}
+
+		base_ptr _select(size_type k) const {
+			base_ptr node = _root();
+			while (node != _nil) {
+				size_type left = _subtree_size(node->left);
+				if (k < left) {
+					node = node->left;
+				} else if (k == left) {
+					return node;
+				} else {
+					k -= left + 1;
+					node = node->right;
+				}
+			}
+			return _nil;
+		}
+
+		void _rotate_left(base_ptr x) {
+			base_ptr y = x->right;
+			x->right = y->left;
+			if (y->left != _nil) {
+				y->left->set_parent(x);
+			}
+			y->set_parent(x->parent());
+			if (_is_root(x)) {
+				_set_root(y);
+			} else if (x == x->parent()->left) {
+				x->parent()->left = y;
+			} else {
+				x->parent()->right = y;
+			}
+			y->left = x;
+			x->set_parent(y);
+			_update(x);
+			_update(y);
+		}
+
+		void _rotate_right(base_ptr x) {
+			base_ptr y = x->left;
+			x->left = y->right;
+			if (y->right != _nil) {
+				y->right->set_parent(x);
+			}
+			y->set_parent(x->parent());
+			if (_is_root(x)) {
+				_set_root(y);
+			} else if (x == x->parent()->right) {
+				x->parent()->right = y;
+			} else {
+				x->parent()->left = y;
+			}
+			y->right = x;
+			x->set_parent(y);
+			_update(x);
+			_update(y);
+		}
+
+		// Subtree sizes are counted up on the way down, where the nodes are
+		// read anyway, instead of recomputed from both children afterwards.
+		void _insert_helper(pointer new_node, base_ptr node) {
+			base_ptr current = node;
+			base_ptr parent = _nil;
+			while (current != _nil) {
+				parent = current;
+				_grow(current, ft::integral_constant<bool, Update::ranked>());
+				if (_comp(_key(new_node), _key(current))) {
+					current = current->left;
+				} else {
+					current = current->right;
+				}
+			}
+			new_node->set_parent(parent);
+			if (_comp(_key(new_node), _key(parent))) {
+				parent->left = new_node;
+			} else {
+				parent->right = new_node;
+			}
+			if (Update::ranked) {
+				_update(new_node);
+			} else {
+				_update_path(new_node);
+			}
+			_insert_fix_up(new_node);
+		}
+
+		void _grow(base_ptr node, ft::true_type) {
+			++static_cast<pointer>(node)->metadata;
+		}
+
+		void _grow(base_ptr, ft::false_type) {}
+
+		// Returns true when the root had turned red, i.e. the black height
+		// of the tree grew by one.
+		bool _insert_fix_up(base_ptr node) {
+			while (node->parent()->color() == RED) {
+				base_ptr parent = node->parent();
+				base_ptr grandparent = parent->parent();
+				if (parent == grandparent->left) {
+					base_ptr uncle = grandparent->right;
+					if (uncle->color() == RED) {
+						parent->set_color(BLACK);
+						uncle->set_color(BLACK);
+						grandparent->set_color(RED);
+						node = grandparent;
+					} else {
+						if (node == parent->right) {
+							node = parent;
+							_rotate_left(node);
+							parent = node->parent();
+						}
+						parent->set_color(BLACK);
+						grandparent->set_color(RED);
+						_rotate_right(grandparent);
+					}
+				} else {
+					base_ptr uncle = grandparent->left;
+					if (uncle->color() == RED) {
+						parent->set_color(BLACK);
+						uncle->set_color(BLACK);
+						grandparent->set_color(RED);
+						node = grandparent;
+					} else {
+						if (node == parent->left) {
+							node = parent;
+							_rotate_right(node);
+							parent = node->parent();
+						}
+						parent->set_color(BLACK);
+						grandparent->set_color(RED);
+						_rotate_left(grandparent);
+					}
+				}
+			}
+			bool grew = _root()->color() == RED;
+			_root()->set_color(BLACK);
+			return grew;
+		}
+
+		void _delete_fix_up(base_ptr node, base_ptr parent) {
+			while (node != _root() && node->color() == BLACK) {
+				if (node == parent->left) {
+					base_ptr tmp = parent->right;
+					if (tmp->color() == RED) {
+						tmp->set_color(BLACK);
+						parent->set_color(RED);
+						_rotate_left(parent);
+						tmp = parent->right;
+					}
+					if (tmp->left->color() == BLACK && tmp->right->color() == BLACK) {
+						tmp->set_color(RED);
+						node = parent;
+						parent = node->parent();
+					} else {
+						if (tmp->right->color() == BLACK) {
+							tmp->left->set_color(BLACK);
+							tmp->set_color(RED);
+							_rotate_right(tmp);
+							tmp = parent->right;
+						}
+						tmp->set_color(parent->color());
+						parent->set_color(BLACK);
+						tmp->right->set_color(BLACK);
+						_rotate_left(parent);
+						node = _root();
+					}
+				} else {
+					base_ptr tmp = parent->left;
+					if (tmp->color() == RED) {
+						tmp->set_color(BLACK);
+						parent->set_color(RED);
+						_rotate_right(parent);
+						tmp = parent->left;
+					}
+					if (tmp->right->color() == BLACK && tmp->left->color() == BLACK) {
+						tmp->set_color(RED);
+						node = parent;
+						parent = node->parent();
+					} else {
+						if (tmp->left->color() == BLACK) {
+							tmp->right->set_color(BLACK);
+							tmp->set_color(RED);
+							_rotate_left(tmp);
+							tmp = parent->left;
+						}
+						tmp->set_color(parent->color());
+						parent->set_color(BLACK);
+						tmp->left->set_color(BLACK);
+						_rotate_right(parent);
+						node = _root();
+					}
+				}
+			}
+			if (node != _nil) {
+				node->set_color(BLACK);
+			}
+		}
+
+		// Puts subtree v in the place of subtree u.
+		void _transplant(base_ptr u, base_ptr v) {
+			if (_is_root(u)) {
+				_set_root(v);
+			} else if (u == u->parent()->left) {
+				u->parent()->left = v;
+			} else {
+				u->parent()->right = v;
+			}
+			if (v != _nil) {
+				v->set_parent(u->parent());
+			}
+		}
+
+		// Unlinks node by relinking its neighbours, so iterators to every
+		// other element stay valid. The nil sentinel is shared between trees
+		// and never written, so the parent of a nil x travels as x_parent.
+		void _erase_helper(base_ptr node, bool destroy = true) {
+			if (!node || node == _nil) {
+				return;
+			}
+			base_ptr x = 0;
+			base_ptr x_parent = 0;
+			base_ptr y = node;
+			color y_color = y->color();
+			if (node->left == _nil) {
+				x = node->right;
+				x_parent = node->parent();
+				_transplant(node, node->right);
+			} else if (node->right == _nil) {
+				x = node->left;
+				x_parent = node->parent();
+				_transplant(node, node->left);
+			} else {
+				y = _minimum(node->right);
+				y_color = y->color();
+				x = y->right;
+				if (y->parent() == node) {
+					x_parent = y;
+				} else {
+					x_parent = y->parent();
+					_transplant(y, y->right);
+					y->right = node->right;
+					y->right->set_parent(y);
+				}
+				_transplant(node, y);
+				y->left = node->left;
+				y->left->set_parent(y);
+				y->set_color(node->color());
+			}
+			_update_path(x_parent);
+			if (destroy) {
+				_delete_node(static_cast<pointer>(node));
+			}
+			if (y_color == BLACK) {
+				_delete_fix_up(x, x_parent);
+			}
+		}
+	};
+
+	// Spellings of red_black_tree for the Tree parameter of ft::map and
+	// ft::set (and of ft::multimap and ft::multiset).
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> >, class Update = rbt_no_update>
+	struct rb_map_tree {
+		typedef red_black_tree<Key, pair<const Key, T>, select_first<pair<const Key, T> >,
+								Compare, Allocator, Update>							type;
+	};
+
+	template<class Key, class Compare = less<Key>,
+			class Allocator = std::allocator<Key>, class Update = rbt_no_update>
+	struct rb_set_tree {
+		typedef red_black_tree<Key, Key, identity<Key>, Compare, Allocator, Update>	type;
+	};
+
+	// With subtree sizes: nth(), rank(), O(log n) ft::distance and count()
+	// of the multi containers.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	struct rb_ranked_map_tree {
+		typedef typename rb_map_tree<Key, T, Compare, Allocator, rbt_order_statistics>::type	type;
+	};
+
+	template<class Key, class Compare = less<Key>, class Allocator = std::allocator<Key> >
+	struct rb_ranked_set_tree {
+		typedef typename rb_set_tree<Key, Compare, Allocator, rbt_order_statistics>::type		type;
+	};
+
+	// With Monoid aggregates of the mapped values, for ft::map::aggregate(),
+	// or of the keys, for ft::set::aggregate().
+	template<class Key, class T, class Monoid, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	struct rb_aggregate_map_tree {
+		typedef typename rb_map_tree<Key, T, Compare, Allocator, rbt_monoid_update<Monoid> >::type	type;
+	};
+
+	template<class Key, class Monoid, class Compare = less<Key>, class Allocator = std::allocator<Key> >
+	struct rb_aggregate_set_tree {
+		typedef typename rb_set_tree<Key, Compare, Allocator, rbt_monoid_update<Monoid> >::type		type;
+	};
+}
+
+#endif
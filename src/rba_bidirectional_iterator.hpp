@@ -0,0 +1,135 @@
+#ifndef RBA_BIDIRECTIONAL_ITERATOR_HPP
+# define RBA_BIDIRECTIONAL_ITERATOR_HPP
+
+# include <cstddef> // ptrdiff_t
+# include <iterator> //std::bidirectional_iterator_tag
+# include "../utils/reverse_iterator.hpp"
+
+namespace ft
+{
+	// Walks an rb_arena_tree. A position is a node index, end() is the nil
+	// index; the iterator keeps the arena rather than a node address, so it
+	// stays valid while the arena grows.
+	template<class Arena>
+	class rba_bidirectional_iterator {
+	public:
+		typedef Arena								arena_type;
+		typedef typename Arena::index_type			index_type;
+		typedef typename Arena::value_type			value_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef typename Arena::value_type const	data_type;
+		typedef data_type*							pointer;
+		typedef data_type const*					const_pointer;
+		typedef data_type&							reference;
+		typedef data_type const&					const_reference;
+		typedef std::bidirectional_iterator_tag		iterator_category;
+		index_type									_index;
+
+	private:
+		arena_type*									_arena;
+
+	public:
+		rba_bidirectional_iterator() : _index(0), _arena(0) {}
+
+		rba_bidirectional_iterator(index_type index, arena_type* arena) :	_index(index),
+																			_arena(arena)
+																			{}
+
+		rba_bidirectional_iterator(const rba_bidirectional_iterator& other) :	_index(other._index),
+																				_arena(other._arena)
+																				{}
+		virtual ~rba_bidirectional_iterator() {}
+
+		rba_bidirectional_iterator& operator=(const rba_bidirectional_iterator& other) {
+			if (this == &other) {
+				return *this;
+			}
+			this->_index = other._index;
+			this->_arena = other._arena;
+			return *this;
+		}
+
+		operator rba_bidirectional_iterator<const arena_type>() const {
+			return rba_bidirectional_iterator<const arena_type>(_index, _arena);
+		}
+
+		reference operator*() {
+			return (*_arena)[_index].data();
+		}
+
+		const_reference operator*() const {
+			return (*_arena)[_index].data();
+		}
+
+		pointer operator->() {
+			return &(operator*());
+		}
+
+		const_pointer operator->() const {
+			return &(operator*());
+		}
+
+		rba_bidirectional_iterator& operator++() {
+			if (_index != arena_type::nil) {
+				_index = _next_node(_index);
+			}
+			return *this;
+		}
+
+		rba_bidirectional_iterator& operator--() {
+			if (_index == arena_type::nil) {
+				_index = _arena->maximum(_arena->root);
+			} else {
+				_index = _prev_node(_index);
+			}
+			return *this;
+		}
+
+		rba_bidirectional_iterator operator++(int) {
+			rba_bidirectional_iterator copy = *this;
+			operator++();
+			return copy;
+		}
+
+		rba_bidirectional_iterator operator--(int) {
+			rba_bidirectional_iterator copy = *this;
+			operator--();
+			return copy;
+		}
+
+		bool operator==(const rba_bidirectional_iterator& other) const {
+			return _index == other._index;
+		}
+
+		bool operator!=(const rba_bidirectional_iterator& other) const {
+			return !(*this == other);
+		}
+
+	private:
+		index_type _next_node(index_type node) const {
+			if ((*_arena)[node].right != arena_type::nil) {
+				return _arena->minimum((*_arena)[node].right);
+			}
+			index_type parent = (*_arena)[node].parent();
+			while (parent != arena_type::nil && node == (*_arena)[parent].right) {
+				node = parent;
+				parent = (*_arena)[parent].parent();
+			}
+			return parent;
+		}
+
+		index_type _prev_node(index_type node) const {
+			if ((*_arena)[node].left != arena_type::nil) {
+				return _arena->maximum((*_arena)[node].left);
+			}
+			index_type parent = (*_arena)[node].parent();
+			while (parent != arena_type::nil && node == (*_arena)[parent].left) {
+				node = parent;
+				parent = (*_arena)[parent].parent();
+			}
+			return parent;
+		}
+	};
+}
+
+#endif
@@ -4,14 +4,22 @@
 # include <cstddef> // ptrdiff_t
 # include <iterator> //std::random_access_iterator_tag
 # include "../utils/reverse_iterator.hpp"
+# include "../utils/type_traits.hpp"
+# include "rbt_node.hpp"
 
 namespace ft
 {
+	// A node of a red_black_tree, or its header for end(). The header is
+	// the parent of the root and its own left child, so an iterator needs
+	// nothing but the node: --end() goes down from the header to the last
+	// element, and an iterator stays valid while its element is in a tree,
+	// whichever tree that is after a split or join.
 	template<class Node>
 	class rbt_bidirectional_iterator {
 	public:
 		typedef Node								value_type;
 		typedef value_type*							node_ptr;
+		typedef rbt_node_base::base_ptr				base_ptr;
 		typedef std::ptrdiff_t						difference_type;
 		typedef typename Node::value_type const		data_type;
 		typedef data_type*							pointer;
@@ -19,24 +27,15 @@ namespace ft
 		typedef data_type&							reference;
 		typedef data_type const&					const_reference;
 		typedef std::bidirectional_iterator_tag		iterator_category;
-		node_ptr									_ptr;
-
-	private:
-		node_ptr									_root;
-		node_ptr									_nil;
+		base_ptr									_ptr;
 
 	public:
-		rbt_bidirectional_iterator() : _ptr(0), _root(0), _nil(0) {}
+		rbt_bidirectional_iterator() : _ptr(0) {}
 
-		rbt_bidirectional_iterator(node_ptr ptr, node_ptr root, node_ptr nil) : _ptr(ptr),
-																				_root(root),
-																				_nil(nil)
-																				{}
+		explicit rbt_bidirectional_iterator(base_ptr ptr) : _ptr(ptr) {}
+
+		rbt_bidirectional_iterator(const rbt_bidirectional_iterator& other) : _ptr(other._ptr) {}
 
-		rbt_bidirectional_iterator(const rbt_bidirectional_iterator& other) :	_ptr(other._ptr),
-																				_root(other._root),
-																				_nil(other._nil)
-																				{}
 		virtual ~rbt_bidirectional_iterator() {}
 
 		rbt_bidirectional_iterator& operator=(const rbt_bidirectional_iterator& other) {
@@ -44,21 +43,19 @@ namespace ft
 				return *this;
 			}
 			this->_ptr = other._ptr;
-			this->_root = other._root;
-			this->_nil = other._nil;
 			return *this;
 		}
 
 		operator rbt_bidirectional_iterator<const value_type>() const {
-			return rbt_bidirectional_iterator<const value_type>(_ptr, _root, _nil);
+			return rbt_bidirectional_iterator<const value_type>(_ptr);
 		}
 
 		reference operator*() {
-			return _ptr->data;
+			return static_cast<node_ptr>(_ptr)->data;
 		}
 
 		const_reference operator*() const {
-			return _ptr->data;
+			return static_cast<node_ptr>(_ptr)->data;
 		}
 
 		pointer operator->() {
@@ -70,16 +67,17 @@ namespace ft
 		}
 
 		rbt_bidirectional_iterator& operator++() {
-			if (_ptr != _nil) {
+			if (!_is_header(_ptr)) {
 				_ptr = _next_node(_ptr);
 			}
 			return *this;
 		}
 
+		// From end() down to the last element in O(log n).
 		rbt_bidirectional_iterator& operator--() {
-			if (_ptr == _nil) {
-				_ptr = _root;
-				while (_ptr->right != _nil && _ptr != _nil) {
+			if (_is_header(_ptr)) {
+				_ptr = _ptr->parent();
+				while (_ptr->right != rbt_nil()) {
 					_ptr = _ptr->right;
 				}
 			} else {
@@ -90,7 +88,7 @@ namespace ft
 
 		rbt_bidirectional_iterator operator++(int) {
 			rbt_bidirectional_iterator copy = *this;
-			_ptr = _next_node(_ptr);
+			operator++();
 			return copy;
 		}
 
@@ -108,54 +106,96 @@ namespace ft
 			return _ptr != other._ptr;
 		}
 
+		// Number of increments from here to last; O(log n) when the nodes
+		// carry subtree sizes, a walk otherwise.
+		difference_type _distance_to(const rbt_bidirectional_iterator& last) const {
+			return _distance_to(last, ft::integral_constant<bool, Node::update_type::ranked>());
+		}
+
 	private:
-		node_ptr _prev_node(node_ptr node) {
-			node_ptr tmp = node;
-			if (tmp->left != _nil) {
+		static bool _is_header(base_ptr node) {
+			return node->left == node;
+		}
+
+		difference_type _distance_to(const rbt_bidirectional_iterator& last, ft::false_type) const {
+			difference_type n = 0;
+			for (rbt_bidirectional_iterator it = *this; it != last; ++it) {
+				++n;
+			}
+			return n;
+		}
+
+		difference_type _distance_to(const rbt_bidirectional_iterator& last, ft::true_type) const {
+			base_ptr root = _is_header(_ptr) ? _ptr->parent() : _ptr;
+			if (root == rbt_nil()) {
+				return 0;
+			}
+			while (!_is_header(root->parent())) {
+				root = root->parent();
+			}
+			return static_cast<difference_type>(_rank(last._ptr, root)) - static_cast<difference_type>(_rank(_ptr, root));
+		}
+
+		static std::size_t _size(base_ptr node) {
+			return node == rbt_nil() ? 0 : static_cast<node_ptr>(node)->metadata;
+		}
+
+		// Elements before node in the tree under root; end() ranks last.
+		static std::size_t _rank(base_ptr node, base_ptr root) {
+			if (_is_header(node)) {
+				return _size(root);
+			}
+			std::size_t rank = _size(node->left);
+			for (base_ptr parent = node->parent(); !_is_header(parent); node = parent, parent = parent->parent()) {
+				if (node == parent->right) {
+					rank += _size(parent->left) + 1;
+				}
+			}
+			return rank;
+		}
+
+		// Past the first element the climb reaches the header, whose left
+		// child is itself and not the root: that is end().
+		static base_ptr _prev_node(base_ptr node) {
+			base_ptr tmp = node;
+			if (tmp->left != rbt_nil()) {
 				tmp = tmp->left;
-				while (tmp->right != _nil) {
+				while (tmp->right != rbt_nil()) {
 					tmp = tmp->right;
 				}
 				return tmp;
-			} else {
-				node_ptr prev_tmp = tmp->parent;
-				while (prev_tmp && tmp == prev_tmp->left) {
-					tmp = prev_tmp;
-					prev_tmp = prev_tmp->parent;
-				}
-				if (!prev_tmp) {
-					return _nil;
-				} else {
-					return prev_tmp;
-				}
 			}
+			base_ptr prev_tmp = tmp->parent();
+			while (tmp == prev_tmp->left) {
+				tmp = prev_tmp;
+				prev_tmp = prev_tmp->parent();
+			}
+			return prev_tmp;
 		}
 
-		node_ptr _next_node(node_ptr node) {
-			node_ptr tmp = node;
-			if (tmp == _nil) {
-				return _nil;
-			}
-			if (tmp->right != _nil) {
+		static base_ptr _next_node(base_ptr node) {
+			base_ptr tmp = node;
+			if (tmp->right != rbt_nil()) {
 				tmp = tmp->right;
-				while (tmp->left != _nil && tmp != _nil) {
+				while (tmp->left != rbt_nil()) {
 					tmp = tmp->left;
 				}
 				return tmp;
-			} else {
-				node_ptr next_tmp = tmp->parent;
-				while (next_tmp != _nil && tmp == next_tmp->right) {
-					tmp = next_tmp;
-					next_tmp = next_tmp->parent;
-				}
-				if (!next_tmp) {
-					return _nil;
-				} else {
-					return next_tmp;
-				}
 			}
+			base_ptr next_tmp = tmp->parent();
+			while (tmp == next_tmp->right) {
+				tmp = next_tmp;
+				next_tmp = next_tmp->parent();
+			}
+			return next_tmp;
 		}
 	};
+
+	template<class Node>
+	typename rbt_bidirectional_iterator<Node>::difference_type
+	distance(const rbt_bidirectional_iterator<Node>& first, const rbt_bidirectional_iterator<Node>& last) {
+		return first._distance_to(last);
+	}
 }
 
 #endif
@@ -0,0 +1,193 @@
+#ifndef RBT_NODE_HPP
+# define RBT_NODE_HPP
+
+# include <cstddef>
+# include <stdint.h>
+# include "../utils/pair.hpp"
+
+namespace ft
+{
+	enum color {RED, BLACK};
+
+	// Links of a tree node, kept apart from the payload. Nodes are at least
+	// pointer-aligned, so the lowest bit of the parent pointer is free and
+	// holds the color: a node is three words instead of three words plus a
+	// padded enum.
+	struct rbt_node_base {
+		typedef rbt_node_base*				base_ptr;
+
+		uintptr_t							parent_color;
+		base_ptr							left;
+		base_ptr							right;
+
+		rbt_node_base() : parent_color(BLACK), left(0), right(0) {}
+
+		base_ptr parent(void) const {
+			return reinterpret_cast<base_ptr>(parent_color & ~static_cast<uintptr_t>(1));
+		}
+
+		void set_parent(base_ptr parent) {
+			parent_color = reinterpret_cast<uintptr_t>(parent) | (parent_color & 1);
+		}
+
+		ft::color color(void) const {
+			return static_cast<ft::color>(parent_color & 1);
+		}
+
+		void set_color(ft::color color) {
+			parent_color = (parent_color & ~static_cast<uintptr_t>(1)) | color;
+		}
+	};
+
+	// The nil leaf shared by every red_black_tree. Trees never write to it,
+	// so a subtree keeps its leaves when it moves to another tree.
+	inline rbt_node_base* rbt_nil(void) {
+		static rbt_node_base nil;
+		return &nil;
+	}
+
+	// Hints that node is about to be read, so its cache line is on the way
+	// while other work goes on. A no-op where the builtin is missing.
+	inline void rbt_prefetch(const rbt_node_base* node) {
+# if defined(__GNUC__)
+		__builtin_prefetch(node);
+# else
+		(void)node;
+# endif
+	}
+
+	// Node update policies for red_black_tree. A policy keeps metadata in
+	// every node, computed from the node and its children (null for nil)
+	// and given the tree's key comparator for policies that order keys;
+	// the tree recomputes it bottom-up wherever the shape changes. When
+	// reads_mapped is set the metadata depends on the mapped value of a
+	// map element, so the tree hands out no writable reference to it.
+	struct rbt_no_update {
+		typedef void						metadata_type;
+		static const bool					enabled = false;
+		static const bool					ranked = false;
+		static const bool					reads_mapped = false;
+
+		template<class Node, class KeyCompare>
+		static void update(Node&, const Node*, const Node*, const KeyCompare&) {}
+	};
+
+	// Subtree sizes: rank, select and O(log n) distance.
+	struct rbt_order_statistics {
+		typedef std::size_t					metadata_type;
+		static const bool					enabled = true;
+		static const bool					ranked = true;
+		static const bool					reads_mapped = false;
+
+		template<class Node, class KeyCompare>
+		static void update(Node& node, const Node* left, const Node* right, const KeyCompare&) {
+			node.metadata = 1 + (left ? left->metadata : 0) + (right ? right->metadata : 0);
+		}
+	};
+
+	// What an element contributes to an aggregate: the mapped value of a
+	// map element, the element itself in a set.
+	template<class T>
+	const T& rbt_aggregated_value(const T& value) {
+		return value;
+	}
+
+	template<class T1, class T2>
+	const T2& rbt_aggregated_value(const ft::pair<T1, T2>& value) {
+		return value.second;
+	}
+
+	// Aggregate of the subtree under Monoid (sum_monoid, min_monoid, ...),
+	// kept in key order so the monoid need not be commutative.
+	template<class Monoid>
+	struct rbt_monoid_update {
+		typedef typename Monoid::result_type	metadata_type;
+		typedef Monoid						monoid_type;
+		static const bool					enabled = true;
+		static const bool					ranked = false;
+		static const bool					reads_mapped = true;
+
+		template<class Node, class KeyCompare>
+		static void update(Node& node, const Node* left, const Node* right, const KeyCompare&) {
+			Monoid op;
+			metadata_type value = metadata_type(rbt_aggregated_value(node.data));
+			if (left) {
+				value = op(left->metadata, value);
+			}
+			if (right) {
+				value = op(value, right->metadata);
+			}
+			node.metadata = value;
+		}
+	};
+
+	// Metadata type of a tree's update policy, void for trees without one.
+	// Lets ft::map declare aggregate() whatever its Tree parameter is.
+	template<class Tree>
+	struct tree_metadata_probe {
+		template<class U>
+		static char test(typename U::metadata_type*);
+
+		template<class U>
+		static long test(...);
+
+		static const bool value = sizeof(test<Tree>(0)) == sizeof(char);
+	};
+
+	template<class Tree, bool = tree_metadata_probe<Tree>::value>
+	struct tree_metadata {
+		typedef void						type;
+	};
+
+	template<class Tree>
+	struct tree_metadata<Tree, true> {
+		typedef typename Tree::metadata_type	type;
+	};
+
+	// What ft::map's at() and operator[] return: the tree's
+	// mapped_reference where it has one, a plain reference otherwise.
+	template<class Tree>
+	struct tree_mapped_reference_probe {
+		template<class U>
+		static char test(typename U::mapped_reference*);
+
+		template<class U>
+		static long test(...);
+
+		static const bool value = sizeof(test<Tree>(0)) == sizeof(char);
+	};
+
+	template<class Tree, class Mapped, bool = tree_mapped_reference_probe<Tree>::value>
+	struct tree_mapped_reference {
+		typedef Mapped&						type;
+	};
+
+	template<class Tree, class Mapped>
+	struct tree_mapped_reference<Tree, Mapped, true> {
+		typedef typename Tree::mapped_reference	type;
+	};
+
+	template<class T, class Update = rbt_no_update>
+	struct rbt_node : public rbt_node_base {
+		typedef T							value_type;
+		typedef Update						update_type;
+		typedef typename Update::metadata_type	metadata_type;
+		typedef rbt_node_base				base_type;
+		metadata_type						metadata;
+		value_type							data;
+
+		rbt_node(const value_type& data) : rbt_node_base(), metadata(), data(data) {}
+	};
+
+	template<class T>
+	struct rbt_node<T, rbt_no_update> : public rbt_node_base {
+		typedef T							value_type;
+		typedef rbt_no_update				update_type;
+		typedef rbt_node_base				base_type;
+		value_type							data;
+
+		rbt_node(const value_type& data) : rbt_node_base(), data(data) {}
+	};
+}
+
+#endif
\ No newline at end of file
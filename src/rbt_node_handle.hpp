@@ -0,0 +1,151 @@
+#ifndef RBT_NODE_HANDLE_HPP
+# define RBT_NODE_HANDLE_HPP
+
+# include <cstddef>
+# include "../utils/pair.hpp"
+
+namespace ft
+{
+	// Key and mapped types a handle exposes: those of a map's pair, the
+	// element itself for a set (where key() and mapped() go unused).
+	template<class T>
+	struct rbt_handle_types {
+		typedef T									key_type;
+		typedef T									mapped_type;
+	};
+
+	template<class T1, class T2>
+	struct rbt_handle_types<ft::pair<T1, T2> > {
+		typedef T1									key_type;
+		typedef T2									mapped_type;
+	};
+
+	// Owns a node taken out of a red_black_tree by extract(), so it can be
+	// inserted into another tree with the same node type without copying
+	// the element or touching the allocator. Without move semantics a copy
+	// transfers ownership, as std::auto_ptr does: the source ends up empty.
+	template<class Node, class Allocator>
+	class rbt_node_handle {
+	public:
+		typedef Node												node_type;
+		typedef typename Node::value_type							value_type;
+		typedef Allocator											allocator_type;
+		typedef typename rbt_handle_types<value_type>::key_type		key_type;
+		typedef typename rbt_handle_types<value_type>::mapped_type	mapped_type;
+
+	private:
+		mutable node_type*											_node;
+		allocator_type												_alloc;
+
+	public:
+		rbt_node_handle() : _node(0), _alloc() {}
+
+		rbt_node_handle(node_type* node, const allocator_type& alloc) : _node(node), _alloc(alloc) {}
+
+		rbt_node_handle(const rbt_node_handle& other) : _node(other._release()), _alloc(other._alloc) {}
+
+		~rbt_node_handle() {
+			_destroy();
+		}
+
+		rbt_node_handle& operator=(const rbt_node_handle& other) {
+			if (this == &other) {
+				return *this;
+			}
+			_destroy();
+			_alloc = other._alloc;
+			_node = other._release();
+			return *this;
+		}
+
+		bool empty(void) const {
+			return _node == 0;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _alloc;
+		}
+
+		// set elements.
+		const value_type& value(void) const {
+			return _node->data;
+		}
+
+		// map elements. The key stays const: changing it in place would
+		// write through the const key of the stored pair.
+		const key_type& key(void) const {
+			return _node->data.first;
+		}
+
+		mapped_type& mapped(void) {
+			return _node->data.second;
+		}
+
+		const mapped_type& mapped(void) const {
+			return _node->data.second;
+		}
+
+		void swap(rbt_node_handle& other) {
+			node_type* node = _node;
+			allocator_type alloc = _alloc;
+			_node = other._node;
+			_alloc = other._alloc;
+			other._node = node;
+			other._alloc = alloc;
+		}
+
+		// Gives up the node without freeing it, for the receiving tree.
+		node_type* _release(void) const {
+			node_type* node = _node;
+			_node = 0;
+			return node;
+		}
+
+	private:
+		void _destroy(void) {
+			if (_node) {
+				_alloc.destroy(_node);
+				_alloc.deallocate(_node, 1);
+				_node = 0;
+			}
+		}
+	};
+
+	// Result of inserting a node handle: where the key is, whether the
+	// node went in, and the node handed back when the key was taken.
+	template<class Iterator, class NodeHandle>
+	struct rbt_insert_return {
+		Iterator									position;
+		bool										inserted;
+		NodeHandle									node;
+	};
+
+	// Stand-in for trees without node handles, so ft::map and ft::set can
+	// declare extract() and the node insert() whatever their Tree is.
+	struct no_node_handle {};
+
+	template<class Tree>
+	struct tree_node_handle_probe {
+		template<class U>
+		static char test(typename U::node_handle*);
+
+		template<class U>
+		static long test(...);
+
+		static const bool value = sizeof(test<Tree>(0)) == sizeof(char);
+	};
+
+	template<class Tree, bool = tree_node_handle_probe<Tree>::value>
+	struct tree_node_handle {
+		typedef no_node_handle						type;
+		typedef no_node_handle						insert_return_type;
+	};
+
+	template<class Tree>
+	struct tree_node_handle<Tree, true> {
+		typedef typename Tree::node_handle			type;
+		typedef typename Tree::insert_return_type	insert_return_type;
+	};
+}
+
+#endif
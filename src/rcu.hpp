@@ -0,0 +1,187 @@
+#ifndef RCU_HPP
+# define RCU_HPP
+
+# include <cstddef>
+# include <pthread.h>
+# include <sched.h>
+# include "../utils/atomic.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	// Quiescent-state-based RCU. Readers do nothing at all around a read:
+	// no counter, no fence, no lock. Instead each reader thread registers
+	// with the domain and calls quiescent_state() at points where it holds
+	// no pointer into the structure, typically between two requests. A
+	// writer that unlinks something retires it; it is freed once every
+	// registered reader has passed a quiescent state since, a grace period.
+	//
+	// A reader that blocks for long (waits on I/O, sleeps) goes offline
+	// first so grace periods do not wait for it, and comes back online
+	// before it reads again. A registered reader that stops reporting
+	// quiescent states delays reclamation but never makes it unsafe.
+	//
+	// Each container owns its domain; its destruction frees all retired
+	// memory. Thread records are found like epoch_domain's: by thread id
+	// on first use, then from a cache for the domain used last.
+	class rcu_domain {
+	public:
+		typedef void (*deleter_type)(void*);
+
+		rcu_domain(void) : _period(1), _records(0), _id(_next_id()) {}
+
+		~rcu_domain(void) {
+			for (std::size_t i = 0; i < _retired.size(); ++i) {
+				_retired[i].deleter(_retired[i].ptr);
+			}
+			_record* rec = _records;
+			while (rec) {
+				_record* next = rec->next;
+				delete rec;
+				rec = next;
+			}
+		}
+
+		void register_thread(void) {
+			_record* rec = _self();
+			atomic_store(&rec->registered, static_cast<std::size_t>(1));
+			thread_online();
+		}
+
+		void unregister_thread(void) {
+			thread_offline();
+			atomic_store(&_self()->registered, static_cast<std::size_t>(0));
+		}
+
+		// The calling reader holds nothing it read before. The fence keeps
+		// the reads of the next section after the report.
+		void quiescent_state(void) {
+			_record* rec = _self();
+			atomic_store(&rec->seen, atomic_load(&_period));
+			atomic_thread_fence();
+		}
+
+		void thread_offline(void) {
+			atomic_store(&_self()->seen, static_cast<std::size_t>(0));
+		}
+
+		void thread_online(void) {
+			atomic_store_fence(&_self()->seen, atomic_load(&_period));
+		}
+
+		// ptr is already unreachable for readers; deleter runs after a
+		// grace period. Writers only, and one at a time.
+		void retire(void* ptr, deleter_type deleter) {
+			std::size_t period = atomic_fetch_add(&_period, 1) + 1;
+			_retired.push_back(_deferred(ptr, deleter, period));
+			reclaim();
+		}
+
+		// Frees whatever a finished grace period allows, without waiting.
+		void reclaim(void) {
+			std::size_t done = _completed();
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < _retired.size(); ++i) {
+				if (_retired[i].period <= done) {
+					_retired[i].deleter(_retired[i].ptr);
+				} else {
+					_retired[kept++] = _retired[i];
+				}
+			}
+			_retired.resize(kept);
+		}
+
+		// Waits for every registered reader to pass a quiescent state, then
+		// frees everything retired. A registered reader calling this would
+		// wait for itself: it goes offline around it.
+		void synchronize(void) {
+			std::size_t target = atomic_fetch_add(&_period, 1) + 1;
+			while (_completed() < target) {
+				sched_yield();
+			}
+			reclaim();
+		}
+
+		std::size_t pending(void) const {
+			return _retired.size();
+		}
+
+	private:
+		struct _deferred {
+			void*			ptr;
+			deleter_type	deleter;
+			std::size_t		period;
+
+			_deferred(void) : ptr(0), deleter(0), period(0) {}
+			_deferred(void* p, deleter_type d, std::size_t g) : ptr(p), deleter(d), period(g) {}
+		};
+
+		struct _record {
+			// Last period seen at a quiescent state; 0 while offline.
+			std::size_t		seen;
+			std::size_t		registered;
+			pthread_t		owner;
+			_record*		next;
+
+			explicit _record(pthread_t self) : seen(0), registered(0), owner(self), next(0) {}
+		};
+
+		struct _cache {
+			std::size_t		id;
+			_record*		rec;
+		};
+
+		std::size_t					_period;
+		_record*					_records;
+		std::size_t					_id;
+		ft::vector<_deferred>		_retired;
+
+		static std::size_t _next_id(void) {
+			static std::size_t last = 0;
+			return atomic_fetch_add(&last, 1) + 1;
+		}
+
+		static _cache& _thread_cache(void) {
+			static __thread _cache cache = {0, 0};
+			return cache;
+		}
+
+		_record* _self(void) {
+			_cache& cache = _thread_cache();
+			if (cache.id == _id) {
+				return cache.rec;
+			}
+			pthread_t self = pthread_self();
+			_record* rec = atomic_load(&_records);
+			while (rec && !pthread_equal(rec->owner, self)) {
+				rec = rec->next;
+			}
+			if (!rec) {
+				rec = new _record(self);
+				rec->next = atomic_load(&_records);
+				while (!atomic_compare_exchange(&_records, rec->next, rec)) {}
+			}
+			cache.id = _id;
+			cache.rec = rec;
+			return rec;
+		}
+
+		// Latest period every online reader has passed.
+		std::size_t _completed(void) {
+			atomic_thread_fence();
+			std::size_t done = atomic_load(&_period);
+			for (_record* rec = atomic_load(&_records); rec; rec = rec->next) {
+				std::size_t seen = atomic_load(&rec->seen);
+				if (atomic_load(&rec->registered) && seen && seen < done) {
+					done = seen;
+				}
+			}
+			return done;
+		}
+
+		rcu_domain(const rcu_domain&);
+		rcu_domain& operator=(const rcu_domain&);
+	};
+}
+
+#endif
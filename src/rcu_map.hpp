@@ -0,0 +1,175 @@
+#ifndef RCU_MAP_HPP
+# define RCU_MAP_HPP
+
+#include <memory>
+#include "../utils/functional.hpp"
+#include "../utils/pair.hpp"
+#include "../utils/atomic.hpp"
+#include "../utils/lock.hpp"
+#include "persistent_map.hpp"
+#include "rcu.hpp"
+
+namespace ft
+{
+	// A map for data that is read on every request and rarely changed.
+	// The current contents are one immutable persistent_map version, and
+	// a lookup is a load of the pointer to it followed by a plain tree
+	// walk: no lock, no reference count, no read-modify-write, no fence.
+	// On x86 the pointer load is an ordinary move.
+	//
+	// A writer copies the current version in O(1), changes the copy (the
+	// nodes on the path to the key, all other subtrees are shared) and
+	// swaps the pointer. The version it replaced may still be walked by
+	// readers, so it is retired to an rcu_domain and released only after a
+	// grace period; releasing it frees the nodes no later version shares.
+	// Writers take turns on a mutex and never wait for readers.
+	//
+	// The price is paid at the edges of a read: a thread that reads calls
+	// register_reader() once and quiescent_state() between requests, at a
+	// point where it keeps nothing it read from the map. A version and all
+	// references into it stay valid until the reading thread's next
+	// quiescent state. See rcu_domain for going offline.
+	template<class Key, class T, class Compare = less<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	class rcu_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef ft::persistent_map<Key, T, Compare, Allocator>							version_type;
+		typedef typename version_type::const_iterator									const_iterator;
+		typedef std::size_t																size_type;
+
+	private:
+		version_type*					_current;
+		ft::mutex						_write_lock;
+		rcu_domain						_domain;
+
+	public:
+		explicit rcu_map(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _current(new version_type(comp, alloc)) {}
+
+		// Readers must be gone; retired versions go with the domain.
+		~rcu_map(void) {
+			delete _current;
+		}
+
+		// Reader threads.
+		void register_reader(void) {
+			_domain.register_thread();
+		}
+
+		void unregister_reader(void) {
+			_domain.unregister_thread();
+		}
+
+		void quiescent_state(void) {
+			_domain.quiescent_state();
+		}
+
+		void reader_offline(void) {
+			_domain.thread_offline();
+		}
+
+		void reader_online(void) {
+			_domain.thread_online();
+		}
+
+		// The current version, to iterate or to make several lookups that
+		// agree with each other. Valid until the next quiescent state.
+		const version_type& read(void) const {
+			return *atomic_load(&_current);
+		}
+
+		bool find(const key_type& key, mapped_type& obj) const {
+			return read().find(key, obj);
+		}
+
+		size_type count(const key_type& key) const {
+			return read().count(key);
+		}
+
+		size_type size(void) const {
+			return read().size();
+		}
+
+		bool empty(void) const {
+			return read().empty();
+		}
+
+		// Writers. Each successful write publishes one version; a write
+		// that changes nothing publishes nothing.
+		bool insert(const value_type& value) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			version_type* next = new version_type(*_current);
+			if (!next->insert(value)) {
+				delete next;
+				return false;
+			}
+			_publish(next);
+			return true;
+		}
+
+		bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			version_type* next = new version_type(*_current);
+			bool inserted = next->insert_or_assign(key, obj);
+			_publish(next);
+			return inserted;
+		}
+
+		size_type erase(const key_type& key) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			if (!_current->count(key)) {
+				return 0;
+			}
+			version_type* next = new version_type(*_current);
+			next->erase(key);
+			_publish(next);
+			return 1;
+		}
+
+		void clear(void) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			_publish(new version_type(_current->key_comp(), _current->get_allocator()));
+		}
+
+		// Waits out a grace period and frees every retired version. The
+		// caller must not be an online reader of this map.
+		void synchronize(void) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			_domain.synchronize();
+		}
+
+		// Versions replaced but not yet freed.
+		size_type retired(void) {
+			ft::lock_guard<ft::mutex> guard(_write_lock);
+			return _domain.pending();
+		}
+
+		key_compare key_comp(void) const {
+			return read().key_comp();
+		}
+
+		allocator_type get_allocator(void) const {
+			return read().get_allocator();
+		}
+
+	private:
+		static void _delete_version(void* version) {
+			delete static_cast<version_type*>(version);
+		}
+
+		void _publish(version_type* next) {
+			version_type* old = atomic_exchange(&_current, next);
+			_domain.retire(old, &_delete_version);
+		}
+
+		rcu_map(const rcu_map&);
+		rcu_map& operator=(const rcu_map&);
+	};
+}
+
+#endif
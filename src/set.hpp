@@ -4,15 +4,19 @@
 #include <memory>
 #include "../utils/functional.hpp"
 #include "../utils/pair.hpp"
-#include "rb_tree_set.hpp"
+#include "rb_tree.hpp"
+#include "bplus_tree.hpp"
+#include "rb_arena_tree.hpp"
 #include "rbt_bidirectional_iterator.hpp"
+#include "rbt_node_handle.hpp"
 #include "../utils/equal.hpp"
 #include "../utils/lexicographical_compare.hpp"
 
 namespace ft
 {
 	template<class Key, class Compare = ft::less<Key>,
-			class Allocator = std::allocator<Key> >
+			class Allocator = std::allocator<Key>,
+			class Tree = ft::red_black_tree<Key, Key, identity<Key>, Compare, Allocator> >
 	class set {
 	public:
 		typedef Key																		key_type;
@@ -22,7 +26,7 @@ namespace ft
 		typedef Compare																	key_compare;
 		typedef Compare																	value_compare;
 		typedef Allocator																allocator_type;
-		typedef typename ft::red_black_tree<value_type, key_compare, allocator_type>	tree_type;
+		typedef Tree																	tree_type;
 		typedef value_type&																reference;
 		typedef const value_type&														const_reference;
 		typedef value_type*																pointer;
@@ -31,6 +35,8 @@ namespace ft
 		typedef typename tree_type::const_iterator										const_iterator;
 		typedef typename tree_type::reverse_iterator									reverse_iterator;
 		typedef typename tree_type::const_reverse_iterator								const_reverse_iterator;
+		typedef typename tree_node_handle<Tree>::type									node_type;
+		typedef typename tree_node_handle<Tree>::insert_return_type						insert_return_type;
 
 		private:
 			tree_type _tree;
@@ -133,6 +139,26 @@ namespace ft
 			return _tree.erase(key);
 		}
 
+		// Node handles (red_black_tree backends): extract() unlinks an
+		// element and insert() links it into another set of the same
+		// element and allocator types, without copying or allocating.
+		node_type extract(iterator pos) {
+			return _tree.extract(pos);
+		}
+
+		node_type extract(const key_type& key) {
+			return _tree.extract(key);
+		}
+
+		insert_return_type insert(node_type handle) {
+			return _tree.insert(handle);
+		}
+
+		// Moves in the elements of other whose keys are not here yet.
+		void merge(set& other) {
+			_tree.merge(other._tree);
+		}
+
 		void swap(set& other) {
 			set tmp = *this;
 			*this = other;
@@ -175,6 +201,116 @@ namespace ft
 			return _tree.upper_bound(key);
 		}
 
+		// Looks up each key in [first, last), writing an iterator per key to
+		// out (end() when missing). Faster than find() in a loop once the
+		// tree no longer fits in cache.
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+			return _tree.find_batch(first, last, out);
+		}
+
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+			return _tree.find_batch(first, last, out);
+		}
+
+		// Heterogeneous lookups, for a transparent Compare such as
+		// ft::less<void>: the key is compared as given, never converted.
+		template<class K>
+		typename enable_if_transparent<Compare, K, size_type>::type count(const K& key) {
+			return _tree.count(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type find(const K& key) {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type find(const K& key) const {
+			return _tree.find(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+			return _tree.equal_range(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, ft::pair<const_iterator, const_iterator> >::type
+		equal_range(const K& key) const {
+			return _tree.equal_range(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type lower_bound(const K& key) {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type lower_bound(const K& key) const {
+			return _tree.lower_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, iterator>::type upper_bound(const K& key) {
+			return _tree.upper_bound(key);
+		}
+
+		template<class K>
+		typename enable_if_transparent<Compare, K, const_iterator>::type upper_bound(const K& key) const {
+			return _tree.upper_bound(key);
+		}
+
+		// Order statistics, for a Tree that keeps subtree sizes
+		// (rb_ranked_map_tree, rb_ranked_set_tree).
+		iterator nth(size_type k) {
+			return _tree.nth(k);
+		}
+
+		const_iterator nth(size_type k) const {
+			return _tree.nth(k);
+		}
+
+		size_type rank(const key_type& key) const {
+			return _tree.rank(key);
+		}
+
+		// Combined values of the elements with keys in [first, last), for a
+		// Tree that keeps aggregates (rb_aggregate_set_tree).
+		typename tree_metadata<Tree>::type aggregate(const key_type& first, const key_type& last) const {
+			return _tree.aggregate(first, last);
+		}
+
+		// Moves the elements not less than key into right, replacing its
+		// contents. O(log n) on rb_ranked_set_tree; the default tree has no
+		// subtree sizes and also counts the smaller part, O(log n + k) for
+		// its k elements, to keep its nodes small.
+		void split(const key_type& key, set& right) {
+			_tree.split(key, right._tree);
+		}
+
+		// Moves every element of other into this set in O(log n) when the
+		// two key ranges do not interleave; other is left empty.
+		void join(set& other) {
+			_tree.join(other._tree);
+		}
+
+		// Set algebra in place: this set becomes the union, intersection or
+		// difference with other, which is left empty (red_black_tree
+		// backends). Copy other first to keep it.
+		void unite(set& other) {
+			_tree.unite(other._tree);
+		}
+
+		void intersect(set& other) {
+			_tree.intersect(other._tree);
+		}
+
+		void subtract(set& other) {
+			_tree.subtract(other._tree);
+		}
+
 		key_compare key_comp(void) const {
 			return _tree.key_comp();
 		}
@@ -184,38 +320,38 @@ namespace ft
 		}
 	};
 
-	template<class Key, class Compare, class Alloc>
-	bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator==(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return ft::equal(lhs.begin(), lhs.end(), rhs.begin()) && lhs.size() == rhs.size();
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator!=(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return !(lhs == rhs);
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator<(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator<=(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return lhs < rhs || lhs == rhs;
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator>(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return rhs < lhs;
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	bool operator>=(const set<Key, Compare, Alloc, Tree>& lhs, const set<Key, Compare, Alloc, Tree>& rhs) {
 		return rhs <= lhs;
 	}
 
-	template<class Key, class Compare, class Alloc>
-	void swap(set<Key, Compare, Alloc>& lhs, set<Key, Compare, Alloc>& rhs) {
+	template<class Key, class Compare, class Alloc, class Tree>
+	void swap(set<Key, Compare, Alloc, Tree>& lhs, set<Key, Compare, Alloc, Tree>& rhs) {
 		lhs.swap(rhs);
 	}
 }
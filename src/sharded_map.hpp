@@ -0,0 +1,359 @@
+#ifndef SHARDED_MAP_HPP
+# define SHARDED_MAP_HPP
+
+#include <memory>
+#include <new>
+#include <iterator>
+#include "../utils/functional.hpp"
+#include "../utils/hash.hpp"
+#include "../utils/pair.hpp"
+#include "../utils/lock.hpp"
+#include "map.hpp"
+
+namespace ft
+{
+	// A map shared between threads, split by key hash into Shards
+	// independent ft::maps, each behind its own reader-writer lock. Two
+	// writes to different shards never wait for each other, so writes
+	// scale with the number of shards instead of queueing on one lock.
+	//
+	// Each shard starts on its own cache line and is padded to a whole
+	// number of lines: taking one shard's lock does not invalidate the line
+	// holding a neighbour's.
+	//
+	// A hash gives no order, so ordered traversal goes through an
+	// ordered_view, which holds every shard's shared lock and merges the
+	// shards' sorted sequences.
+	template<class Key, class T, std::size_t Shards = 16, class Hash = ft::hash<Key>,
+			class Compare = less<Key>, class Allocator = std::allocator<pair<const Key, T> > >
+	class sharded_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Hash																	hasher;
+		typedef Compare																	key_compare;
+		typedef Allocator																allocator_type;
+		typedef ft::map<key_type, mapped_type, key_compare, allocator_type>				map_type;
+		typedef std::size_t																size_type;
+
+	private:
+		struct _shard_body {
+			mutable ft::rw_lock		lock;
+			map_type				map;
+
+			_shard_body(const key_compare& comp, const allocator_type& alloc) : map(comp, alloc) {}
+		};
+
+		// The alignment rounds sizeof(_shard) up to the next whole line, and
+		// adds nothing when the body already fills whole lines.
+		struct __attribute__((aligned(cache_line_size))) _shard : _shard_body {
+			_shard(const key_compare& comp, const allocator_type& alloc) : _shard_body(comp, alloc) {}
+		};
+
+		void*						_storage;
+		_shard*						_shards;
+		hasher						_hash;
+		key_compare					_comp;
+
+	public:
+		class ordered_view;
+
+		explicit sharded_map(const hasher& hash = hasher(), const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _hash(hash), _comp(comp) {
+			// operator new only promises alignment for fundamental types,
+			// so over-allocate by a line and align by hand.
+			_storage = ::operator new(sizeof(_shard) * Shards + cache_line_size);
+			std::size_t address = reinterpret_cast<std::size_t>(_storage);
+			_shards = reinterpret_cast<_shard*>((address + cache_line_size - 1) & ~(cache_line_size - 1));
+			for (size_type i = 0; i < Shards; ++i) {
+				new (&_shards[i]) _shard(comp, alloc);
+			}
+		}
+
+		~sharded_map() {
+			for (size_type i = 0; i < Shards; ++i) {
+				_shards[i].~_shard();
+			}
+			::operator delete(_storage);
+		}
+
+		bool find(const key_type& key, mapped_type& obj) const {
+			const _shard& shard = _shard_of(key);
+			ft::shared_lock_guard<ft::rw_lock> guard(shard.lock);
+			typename map_type::const_iterator it = shard.map.find(key);
+			if (it == shard.map.end()) {
+				return false;
+			}
+			obj = it->second;
+			return true;
+		}
+
+		size_type count(const key_type& key) const {
+			const _shard& shard = _shard_of(key);
+			ft::shared_lock_guard<ft::rw_lock> guard(shard.lock);
+			return shard.map.find(key) != shard.map.end() ? 1 : 0;
+		}
+
+		bool insert(const value_type& value) {
+			_shard& shard = _shard_of(value.first);
+			ft::lock_guard<ft::rw_lock> guard(shard.lock);
+			return shard.map.insert(value).second;
+		}
+
+		// True if key was new.
+		bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+			_shard& shard = _shard_of(key);
+			ft::lock_guard<ft::rw_lock> guard(shard.lock);
+			return shard.map.insert_or_assign(key, obj).second;
+		}
+
+		size_type erase(const key_type& key) {
+			_shard& shard = _shard_of(key);
+			ft::lock_guard<ft::rw_lock> guard(shard.lock);
+			return shard.map.erase(key);
+		}
+
+		// size(), empty() and clear() visit the shards one at a time, so
+		// under concurrent writes they see each shard at a different moment.
+		size_type size(void) const {
+			size_type total = 0;
+			for (size_type i = 0; i < Shards; ++i) {
+				ft::shared_lock_guard<ft::rw_lock> guard(_shards[i].lock);
+				total += _shards[i].map.size();
+			}
+			return total;
+		}
+
+		bool empty(void) const {
+			for (size_type i = 0; i < Shards; ++i) {
+				ft::shared_lock_guard<ft::rw_lock> guard(_shards[i].lock);
+				if (!_shards[i].map.empty()) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void clear(void) {
+			for (size_type i = 0; i < Shards; ++i) {
+				ft::lock_guard<ft::rw_lock> guard(_shards[i].lock);
+				_shards[i].map.clear();
+			}
+		}
+
+		size_type shard_count(void) const {
+			return Shards;
+		}
+
+		hasher hash_function(void) const {
+			return _hash;
+		}
+
+		key_compare key_comp(void) const {
+			return _comp;
+		}
+
+		// Every element in key order, as of the moment the view was made:
+		// the view holds the shared lock of every shard until it is
+		// destroyed, so writers wait meanwhile. Locks are taken in shard
+		// order, so views on several threads do not deadlock.
+		//
+		// The thread holding a view must not call the map at all, reads
+		// included: rw_lock is not recursive and lets a waiting writer go
+		// first, so a second shared lock queues behind a writer that waits
+		// on the view. Lookups go through the view instead, which reads
+		// under the locks it already holds.
+		class ordered_view {
+		public:
+			// A k-way merge: a min-heap of the shards that still have
+			// elements, ordered by each one's current element. Each step
+			// is O(log Shards).
+			class const_iterator {
+			public:
+				typedef std::ptrdiff_t								difference_type;
+				typedef typename sharded_map::value_type			value_type;
+				typedef const value_type*							pointer;
+				typedef const value_type&							reference;
+				typedef std::forward_iterator_tag					iterator_category;
+
+			private:
+				typedef typename map_type::const_iterator			shard_iterator;
+
+				shard_iterator										_pos[Shards];
+				shard_iterator										_end[Shards];
+				size_type											_heap[Shards];
+				size_type											_heap_size;
+				key_compare											_comp;
+
+			public:
+				const_iterator(void) : _heap_size(0) {
+					for (size_type i = 0; i < Shards; ++i) {
+						_pos[i] = shard_iterator();
+						_end[i] = shard_iterator();
+						_heap[i] = 0;
+					}
+				}
+
+				const_iterator(const _shard* shards, const key_compare& comp) : _heap_size(0), _comp(comp) {
+					for (size_type i = 0; i < Shards; ++i) {
+						_pos[i] = shards[i].map.begin();
+						_end[i] = shards[i].map.end();
+						_heap[i] = 0;
+					}
+					for (size_type i = 0; i < Shards; ++i) {
+						if (_pos[i] != _end[i]) {
+							_heap[_heap_size] = i;
+							_sift_up(_heap_size++);
+						}
+					}
+				}
+
+				reference operator*(void) const {
+					return *_pos[_heap[0]];
+				}
+
+				pointer operator->(void) const {
+					return &*_pos[_heap[0]];
+				}
+
+				const_iterator& operator++(void) {
+					size_type shard = _heap[0];
+					if (++_pos[shard] == _end[shard]) {
+						_heap[0] = _heap[--_heap_size];
+					}
+					if (_heap_size) {
+						_sift_down(0);
+					}
+					return *this;
+				}
+
+				const_iterator operator++(int) {
+					const_iterator tmp = *this;
+					++*this;
+					return tmp;
+				}
+
+				bool operator==(const const_iterator& other) const {
+					if (_heap_size != other._heap_size) {
+						return false;
+					}
+					return !_heap_size || (_heap[0] == other._heap[0] && _pos[_heap[0]] == other._pos[_heap[0]]);
+				}
+
+				bool operator!=(const const_iterator& other) const {
+					return !(*this == other);
+				}
+
+			private:
+				bool _before(size_type a, size_type b) const {
+					return _comp(_pos[a]->first, _pos[b]->first);
+				}
+
+				void _sift_up(size_type i) {
+					while (i && _before(_heap[i], _heap[(i - 1) / 2])) {
+						size_type parent = (i - 1) / 2;
+						size_type tmp = _heap[i];
+						_heap[i] = _heap[parent];
+						_heap[parent] = tmp;
+						i = parent;
+					}
+				}
+
+				void _sift_down(size_type i) {
+					for (;;) {
+						size_type least = i;
+						size_type left = 2 * i + 1;
+						size_type right = left + 1;
+						if (left < _heap_size && _before(_heap[left], _heap[least])) {
+							least = left;
+						}
+						if (right < _heap_size && _before(_heap[right], _heap[least])) {
+							least = right;
+						}
+						if (least == i) {
+							return;
+						}
+						size_type tmp = _heap[i];
+						_heap[i] = _heap[least];
+						_heap[least] = tmp;
+						i = least;
+					}
+				}
+			};
+
+			explicit ordered_view(const sharded_map& map) : _map(map) {
+				for (size_type i = 0; i < Shards; ++i) {
+					_map._shards[i].lock.lock_shared();
+				}
+			}
+
+			~ordered_view(void) {
+				for (size_type i = Shards; i > 0; --i) {
+					_map._shards[i - 1].lock.unlock_shared();
+				}
+			}
+
+			const_iterator begin(void) const {
+				return const_iterator(_map._shards, _map._comp);
+			}
+
+			const_iterator end(void) const {
+				return const_iterator();
+			}
+
+			// The map's lookups, under the locks the view holds.
+			bool find(const key_type& key, mapped_type& obj) const {
+				const map_type& map = _map._shard_of(key).map;
+				typename map_type::const_iterator it = map.find(key);
+				if (it == map.end()) {
+					return false;
+				}
+				obj = it->second;
+				return true;
+			}
+
+			size_type count(const key_type& key) const {
+				const map_type& map = _map._shard_of(key).map;
+				return map.find(key) != map.end() ? 1 : 0;
+			}
+
+			size_type size(void) const {
+				size_type total = 0;
+				for (size_type i = 0; i < Shards; ++i) {
+					total += _map._shards[i].map.size();
+				}
+				return total;
+			}
+
+			bool empty(void) const {
+				for (size_type i = 0; i < Shards; ++i) {
+					if (!_map._shards[i].map.empty()) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+		private:
+			const sharded_map&	_map;
+
+			ordered_view(const ordered_view&);
+			ordered_view& operator=(const ordered_view&);
+		};
+
+	private:
+		_shard& _shard_of(const key_type& key) {
+			return _shards[_hash(key) % Shards];
+		}
+
+		const _shard& _shard_of(const key_type& key) const {
+			return _shards[_hash(key) % Shards];
+		}
+
+		sharded_map(const sharded_map&);
+		sharded_map& operator=(const sharded_map&);
+	};
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef UNORDERED_MAP_HPP
+# define UNORDERED_MAP_HPP
+
+#include <memory>
+#include <stdexcept>
+#include "../utils/functional.hpp"
+#include "../utils/hash.hpp"
+#include "../utils/pair.hpp"
+#include "hash_table.hpp"
+
+namespace ft
+{
+	template<class Key, class T, class Hash = ft::hash<Key>, class KeyEqual = ft::equal_to<Key>,
+			class Allocator = std::allocator<pair<const Key, T> > >
+	class unordered_map {
+	public:
+		typedef Key																		key_type;
+		typedef T																		mapped_type;
+		typedef ft::pair<const key_type, mapped_type>									value_type;
+		typedef Hash																	hasher;
+		typedef KeyEqual																key_equal;
+		typedef Allocator																allocator_type;
+		typedef ft::hash_table<key_type, value_type, ft::select_first<value_type>,
+								hasher, key_equal, allocator_type>						table_type;
+		typedef value_type&																reference;
+		typedef const value_type&														const_reference;
+		typedef value_type*																pointer;
+		typedef const value_type*														const_pointer;
+		typedef std::size_t																size_type;
+		typedef std::ptrdiff_t															difference_type;
+		typedef typename table_type::iterator											iterator;
+		typedef typename table_type::const_iterator										const_iterator;
+
+	private:
+		table_type _table;
+
+	public:
+		explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(),
+								const key_equal& equal = key_equal(),
+								const allocator_type& alloc = allocator_type()) : _table(bucket_count, hash, equal, alloc) {}
+
+		template<class InputIt>
+		unordered_map(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(),
+						const key_equal& equal = key_equal(),
+						const allocator_type& alloc = allocator_type()) : _table(bucket_count, hash, equal, alloc) {
+			_table.insert(first, last);
+		}
+
+		unordered_map(const unordered_map& other) : _table(other._table) {}
+
+		~unordered_map() {}
+
+		unordered_map& operator=(const unordered_map& other) {
+			_table = other._table;
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _table.get_allocator();
+		}
+
+		iterator begin(void) {
+			return _table.begin();
+		}
+
+		const_iterator begin(void) const {
+			return _table.begin();
+		}
+
+		iterator end(void) {
+			return _table.end();
+		}
+
+		const_iterator end(void) const {
+			return _table.end();
+		}
+
+		bool empty(void) const {
+			return _table.empty();
+		}
+
+		size_type size(void) const {
+			return _table.size();
+		}
+
+		size_type max_size(void) const {
+			return _table.max_size();
+		}
+
+		void clear(void) {
+			_table.clear();
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			return _table.insert(value);
+		}
+
+		iterator insert(iterator hint, const value_type& value) {
+			return _table.insert(hint, value);
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last) {
+			_table.insert(first, last);
+		}
+
+		void erase(iterator pos) {
+			_table.erase(pos);
+		}
+
+		void erase(iterator first, iterator last) {
+			_table.erase(first, last);
+		}
+
+		size_type erase(const key_type& key) {
+			return _table.erase(key);
+		}
+
+		void swap(unordered_map& other) {
+			_table.swap(other._table);
+		}
+
+		mapped_type& at(const key_type& key) {
+			iterator it = _table.find(key);
+			if (it == _table.end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return it->second;
+		}
+
+		const mapped_type& at(const key_type& key) const {
+			const_iterator it = _table.find(key);
+			if (it == _table.end()) {
+				throw std::out_of_range("Out of range");
+			}
+			return it->second;
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			iterator it = _table.find(key);
+			if (it == _table.end()) {
+				it = _table.insert(value_type(key, mapped_type())).first;
+			}
+			return it->second;
+		}
+
+		size_type count(const key_type& key) const {
+			return _table.count(key);
+		}
+
+		iterator find(const key_type& key) {
+			return _table.find(key);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return _table.find(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			iterator it = _table.find(key);
+			if (it == _table.end()) {
+				return ft::make_pair(it, it);
+			}
+			iterator next = it;
+			return ft::make_pair(it, ++next);
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			const_iterator it = _table.find(key);
+			if (it == _table.end()) {
+				return ft::make_pair(it, it);
+			}
+			const_iterator next = it;
+			return ft::make_pair(it, ++next);
+		}
+
+		size_type bucket_count(void) const {
+			return _table.bucket_count();
+		}
+
+		float load_factor(void) const {
+			return _table.load_factor();
+		}
+
+		float max_load_factor(void) const {
+			return _table.max_load_factor();
+		}
+
+		void rehash(size_type count) {
+			_table.rehash(count);
+		}
+
+		void reserve(size_type count) {
+			_table.reserve(count);
+		}
+
+		hasher hash_function(void) const {
+			return _table.hash_function();
+		}
+
+		key_equal key_eq(void) const {
+			return _table.key_eq();
+		}
+	};
+
+	template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+					const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+		if (lhs.size() != rhs.size()) {
+			return false;
+		}
+		typedef typename unordered_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator const_iterator;
+		for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+			const_iterator other = rhs.find(it->first);
+			if (other == rhs.end() || !(other->second == it->second)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+					const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs, unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+#ifndef UNORDERED_SET_HPP
+# define UNORDERED_SET_HPP
+
+#include <memory>
+#include "../utils/functional.hpp"
+#include "../utils/hash.hpp"
+#include "../utils/pair.hpp"
+#include "hash_table.hpp"
+
+namespace ft
+{
+	template<class Key, class Hash = ft::hash<Key>, class KeyEqual = ft::equal_to<Key>,
+			class Allocator = std::allocator<Key> >
+	class unordered_set {
+	public:
+		typedef Key																		key_type;
+		typedef Key																		value_type;
+		typedef Hash																	hasher;
+		typedef KeyEqual																key_equal;
+		typedef Allocator																allocator_type;
+		typedef ft::hash_table<key_type, value_type, ft::identity<value_type>,
+								hasher, key_equal, allocator_type>						table_type;
+		typedef value_type&																reference;
+		typedef const value_type&														const_reference;
+		typedef value_type*																pointer;
+		typedef const value_type*														const_pointer;
+		typedef std::size_t																size_type;
+		typedef std::ptrdiff_t															difference_type;
+		typedef typename table_type::const_iterator										iterator;
+		typedef typename table_type::const_iterator										const_iterator;
+
+	private:
+		table_type _table;
+
+	public:
+		explicit unordered_set(size_type bucket_count = 0, const hasher& hash = hasher(),
+								const key_equal& equal = key_equal(),
+								const allocator_type& alloc = allocator_type()) : _table(bucket_count, hash, equal, alloc) {}
+
+		template<class InputIt>
+		unordered_set(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(),
+						const key_equal& equal = key_equal(),
+						const allocator_type& alloc = allocator_type()) : _table(bucket_count, hash, equal, alloc) {
+			_table.insert(first, last);
+		}
+
+		unordered_set(const unordered_set& other) : _table(other._table) {}
+
+		~unordered_set() {}
+
+		unordered_set& operator=(const unordered_set& other) {
+			_table = other._table;
+			return *this;
+		}
+
+		allocator_type get_allocator(void) const {
+			return _table.get_allocator();
+		}
+
+		const_iterator begin(void) const {
+			return _table.begin();
+		}
+
+		const_iterator end(void) const {
+			return _table.end();
+		}
+
+		bool empty(void) const {
+			return _table.empty();
+		}
+
+		size_type size(void) const {
+			return _table.size();
+		}
+
+		size_type max_size(void) const {
+			return _table.max_size();
+		}
+
+		void clear(void) {
+			_table.clear();
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value) {
+			return _table.insert(value);
+		}
+
+		iterator insert(const_iterator hint, const value_type& value) {
+			(void)hint;
+			return _table.insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last) {
+			_table.insert(first, last);
+		}
+
+		void erase(const_iterator pos) {
+			_table.erase(pos);
+		}
+
+		void erase(const_iterator first, const_iterator last) {
+			_table.erase(first, last);
+		}
+
+		size_type erase(const key_type& key) {
+			return _table.erase(key);
+		}
+
+		void swap(unordered_set& other) {
+			_table.swap(other._table);
+		}
+
+		size_type count(const key_type& key) const {
+			return _table.count(key);
+		}
+
+		const_iterator find(const key_type& key) const {
+			return _table.find(key);
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			const_iterator it = _table.find(key);
+			if (it == _table.end()) {
+				return ft::make_pair(it, it);
+			}
+			const_iterator next = it;
+			return ft::make_pair(it, ++next);
+		}
+
+		size_type bucket_count(void) const {
+			return _table.bucket_count();
+		}
+
+		float load_factor(void) const {
+			return _table.load_factor();
+		}
+
+		float max_load_factor(void) const {
+			return _table.max_load_factor();
+		}
+
+		void rehash(size_type count) {
+			_table.rehash(count);
+		}
+
+		void reserve(size_type count) {
+			_table.reserve(count);
+		}
+
+		hasher hash_function(void) const {
+			return _table.hash_function();
+		}
+
+		key_equal key_eq(void) const {
+			return _table.key_eq();
+		}
+	};
+
+	template<class Key, class Hash, class KeyEqual, class Alloc>
+	bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+					const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+		if (lhs.size() != rhs.size()) {
+			return false;
+		}
+		typedef typename unordered_set<Key, Hash, KeyEqual, Alloc>::const_iterator const_iterator;
+		for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+			if (!rhs.count(*it)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Alloc>
+	bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+					const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Alloc>
+	void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& lhs, unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+}
+
+#endif
\ No newline at end of file
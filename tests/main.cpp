@@ -2,11 +2,35 @@ void test_vector();
 void test_map();
 void test_stack();
 void test_set();
+void test_unordered_map();
+void test_unordered_set();
+void test_interval_map();
+void test_multimap();
+void test_multiset();
+void test_concurrent_map();
+void test_sharded_map();
+void test_concurrent_skiplist_map();
+void test_persistent_map();
+void test_rcu_map();
+void test_concurrent_stack();
+void test_concurrent_vector();
 
 int main() {
     test_vector();
 //    test_map();
 //    test_stack();
 //    test_set();
+//    test_unordered_map();
+//    test_unordered_set();
+//    test_interval_map();
+//    test_multimap();
+//    test_multiset();
+//    test_concurrent_map();
+//    test_sharded_map();
+//    test_concurrent_skiplist_map();
+//    test_persistent_map();
+//    test_rcu_map();
+//    test_concurrent_stack();
+//    test_concurrent_vector();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include "../src/concurrent_map.hpp"
+#include "../src/map.hpp"
+#include <map>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include "test_threads.hpp"
+
+typedef std::map<int, int> stl_map_type;
+typedef ft::concurrent_map<int, int> ft_concurrent_map;
+
+static const int thread_count = 8;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+// Copies the elements out through for_each, the only way to walk the map.
+struct collect_elements {
+  std::vector<std::pair<int, int> > *out;
+
+  void operator()(const ft::pair<const int, int> &value) {
+	out->push_back(std::make_pair(value.first, value.second));
+  }
+};
+
+static std::string
+is_equal_content(const stl_map_type &stl_map, const ft_concurrent_map &ft_map) {
+  std::vector<std::pair<int, int> > elements;
+  collect_elements collect;
+  collect.out = &elements;
+  ft_map.for_each(collect);
+  if (elements.size() != stl_map.size())
+	return ("NOT EQUAL");
+  stl_map_type::const_iterator stl_it = stl_map.begin();
+  for (size_t i = 0; i < elements.size(); i++, stl_it++) {
+	if (elements[i].first != stl_it->first || elements[i].second != stl_it->second)
+	  return ("NOT EQUAL");
+  }
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_map_type &stl_map, ft_concurrent_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft concurrent map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Concurrent Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+struct writer_args {
+  ft_concurrent_map *map;
+  int thread;
+  int lost_writes;
+};
+
+// Each thread owns the keys equal to its number modulo thread_count.
+static void *
+writer_thread(void *arg) {
+  writer_args *args = static_cast<writer_args *>(arg);
+  for (int i = 0; i < 2000; i++) {
+	int key = i * thread_count + args->thread;
+	args->map->insert(ft::make_pair(key, i));
+	int value = -1;
+	if (!args->map->find(key, value) || value != i)
+	  args->lost_writes++;
+  }
+  for (int i = 0; i < 2000; i += 3)
+	args->map->erase(i * thread_count + args->thread);
+  for (int i = 1; i < 2000; i += 3)
+	args->map->insert_or_assign(i * thread_count + args->thread, -i);
+  return 0;
+}
+
+// ft::map behind one mutex: what concurrent_map replaces.
+struct locked_map {
+  ft::map<int, int> map;
+  ft::mutex lock;
+
+  bool find(int key, int &value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	ft::map<int, int>::iterator it = map.find(key);
+	if (it == map.end())
+	  return false;
+	value = it->second;
+	return true;
+  }
+
+  void insert_or_assign(int key, int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.insert_or_assign(key, value);
+  }
+
+  void erase(int key) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.erase(key);
+  }
+};
+
+template<class Map>
+struct bench_args {
+  Map *map;
+  int thread;
+  int read_percent;
+  long found;
+};
+
+template<class Map>
+static void *
+bench_thread(void *arg) {
+  bench_args<Map> *args = static_cast<bench_args<Map> *>(arg);
+  unsigned int seed = 12345u + args->thread * 7919u;
+  int value;
+  for (int i = 0; i < 50000; i++) {
+	seed = seed * 1103515245u + 12345u;
+	int key = (seed >> 8) % 65536;
+	int dice = (seed >> 4) % 100;
+	if (dice < args->read_percent)
+	  args->found += args->map->find(key, value);
+	else if (dice % 2)
+	  args->map->insert_or_assign(key, i);
+	else
+	  args->map->erase(key);
+  }
+  return 0;
+}
+
+template<class Map>
+static double
+run_bench(Map &map, int read_percent, long &found) {
+  bench_args<Map> args[thread_count];
+  for (int i = 0; i < 65536; i += 2)
+	map.insert_or_assign(i, i);
+  for (int t = 0; t < thread_count; t++) {
+	args[t].map = &map;
+	args[t].thread = t;
+	args[t].read_percent = read_percent;
+	args[t].found = 0;
+  }
+  double start = wall_ms();
+  run_threads(bench_thread<Map>, args, sizeof(args[0]), thread_count);
+  double end = wall_ms();
+  found = 0;
+  for (int t = 0; t < thread_count; t++)
+	found += args[t].found;
+  return end - start;
+}
+
+void
+test_concurrent_map() {
+  std::cout << "**********CONCURRENT MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_map_type stl_map;
+	ft_concurrent_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE";
+
+	stl_map_type stl_map;
+	ft_concurrent_map ft_map;
+
+	for (int i = 0; i < 1000; i++) {
+	  int key = (i * 7919) % 1009;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+	for (int key = 0; key < 1009; key += 5) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	for (int key = 1; key < 1009; key += 7) {
+	  stl_map[key] = -key;
+	  ft_map.insert_or_assign(key, -key);
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "FIND / COUNT";
+
+	int stl_value = stl_map.find(8)->second;
+	int ft_value = 0;
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Map find (8) = " << stl_value << std::endl;
+	std::cout << "FT Concurrent Map find (8) = " << ft_map.find(8, ft_value) << " " << ft_value << std::endl;
+	std::cout << "STL Map count (10) = " << stl_map.count(10) << std::endl;
+	std::cout << "FT Concurrent Map count (10) = " << ft_map.count(10) << std::endl;
+	std::cout << "\n";
+
+	testName = "CLEAR";
+
+	stl_map.clear();
+	ft_map.clear();
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "CONCURRENT WRITERS";
+
+	stl_map_type stl_map;
+	ft_concurrent_map ft_map;
+	writer_args args[thread_count];
+
+	for (int t = 0; t < thread_count; t++) {
+	  args[t].map = &ft_map;
+	  args[t].thread = t;
+	  args[t].lost_writes = 0;
+	}
+	run_threads(writer_thread, args, sizeof(args[0]), thread_count);
+	int lost_writes = 0;
+	for (int t = 0; t < thread_count; t++) {
+	  lost_writes += args[t].lost_writes;
+	  for (int i = 0; i < 2000; i++) {
+		if (i % 3 == 1)
+		  stl_map[i * thread_count + t] = -i;
+		else if (i % 3 == 2)
+		  stl_map[i * thread_count + t] = i;
+	  }
+	}
+
+	std::cout << "Writes not seen by their own thread: " << lost_writes << std::endl;
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int read_percents[] = {95, 50};
+
+	for (int mix = 0; mix < 2; mix++) {
+	  long found_locked, found_concurrent;
+	  locked_map *baseline = new locked_map;
+	  ft_concurrent_map *concurrent = new ft_concurrent_map;
+
+	  //один мьютекс на всю карту
+	  double time_taken_locked = run_bench(*baseline, read_percents[mix], found_locked);
+	  std::cout << read_percents[mix] << "/" << 100 - read_percents[mix]
+				<< " mutex map time is " << time_taken_locked << " ms" << std::endl;
+
+	  //читатели параллельно, записи пачками
+	  double time_taken_concurrent = run_bench(*concurrent, read_percents[mix], found_concurrent);
+	  std::cout << read_percents[mix] << "/" << 100 - read_percents[mix]
+				<< " concurrent map time is " << time_taken_concurrent << " ms" << std::endl;
+	  std::cout << "Concurrent map faster in " << time_taken_locked / time_taken_concurrent << " times" << std::endl;
+	  delete baseline;
+	  delete concurrent;
+	}
+	std::cout << "\n";
+  }
+}
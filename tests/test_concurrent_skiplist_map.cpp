@@ -0,0 +1,312 @@
+#include "../src/concurrent_skiplist_map.hpp"
+#include "../src/map.hpp"
+#include "../utils/lock.hpp"
+#include <map>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include "test_threads.hpp"
+
+typedef std::map<int, int> stl_map_type;
+typedef ft::concurrent_skiplist_map<int, int> ft_skiplist_map;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_map_type &stl_map, const ft_skiplist_map &ft_map) {
+  ft_skiplist_map::const_iterator ft_it = ft_map.begin();
+  for (stl_map_type::const_iterator stl_it = stl_map.begin(); stl_it != stl_map.end(); stl_it++, ft_it++) {
+	if (ft_it == ft_map.end() || ft_it->first != stl_it->first || ft_it->second != stl_it->second)
+	  return ("NOT EQUAL");
+  }
+  if (ft_it != ft_map.end())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_map_type &stl_map, ft_skiplist_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft skip list map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Skip List Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+struct skiplist_writer_args {
+  ft_skiplist_map *map;
+  int thread;
+  int threads;
+  int lost_writes;
+};
+
+// Each thread owns the keys equal to its number modulo the thread count.
+static void *
+skiplist_writer_thread(void *arg) {
+  skiplist_writer_args *args = static_cast<skiplist_writer_args *>(arg);
+  for (int i = 0; i < 2000; i++) {
+	int key = i * args->threads + args->thread;
+	args->map->insert(ft::make_pair(key, i));
+	ft_skiplist_map::const_iterator it = args->map->find(key);
+	if (it == args->map->end() || it->second != i)
+	  args->lost_writes++;
+  }
+  for (int i = 0; i < 2000; i += 3)
+	args->map->erase(i * args->threads + args->thread);
+  return 0;
+}
+
+// Every thread inserts and erases the same few keys, so links are raced
+// for and nodes are retired while others walk past them.
+static void *
+skiplist_contended_thread(void *arg) {
+  skiplist_writer_args *args = static_cast<skiplist_writer_args *>(arg);
+  unsigned int seed = 777u + args->thread * 7919u;
+  for (int i = 0; i < 20000; i++) {
+	seed = seed * 1103515245u + 12345u;
+	int key = (seed >> 8) % 64;
+	if ((seed >> 4) % 2)
+	  args->map->insert(ft::make_pair(key, key));
+	else
+	  args->map->erase(key);
+	if (i % 1000 == 0) {
+	  int previous = -1;
+	  for (ft_skiplist_map::const_iterator it = args->map->begin(); it != args->map->end(); ++it) {
+		if (it->first <= previous || it->second != it->first)
+		  args->lost_writes++;
+		previous = it->first;
+	  }
+	}
+  }
+  return 0;
+}
+
+// ft::map behind one mutex: the baseline the skip list has to beat.
+struct skiplist_baseline_map {
+  ft::map<int, int> map;
+  ft::mutex lock;
+
+  bool find(int key) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	return map.find(key) != map.end();
+  }
+
+  void insert(int key, int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.insert(ft::make_pair(key, value));
+  }
+
+  void erase(int key) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.erase(key);
+  }
+};
+
+struct skiplist_adapter {
+  ft_skiplist_map map;
+
+  bool find(int key) {
+	return map.count(key) != 0;
+  }
+
+  void insert(int key, int value) {
+	map.insert(ft::make_pair(key, value));
+  }
+
+  void erase(int key) {
+	map.erase(key);
+  }
+};
+
+template<class Map>
+struct skiplist_scaling_args {
+  Map *map;
+  int thread;
+  int ops;
+  long found;
+};
+
+// 20% reads, 80% writes spread over a 64K key space.
+template<class Map>
+static void *
+skiplist_scaling_thread(void *arg) {
+  skiplist_scaling_args<Map> *args = static_cast<skiplist_scaling_args<Map> *>(arg);
+  unsigned int seed = 12345u + args->thread * 7919u;
+  for (int i = 0; i < args->ops; i++) {
+	seed = seed * 1103515245u + 12345u;
+	int key = (seed >> 8) % 65536;
+	int dice = (seed >> 4) % 10;
+	if (dice < 2)
+	  args->found += args->map->find(key);
+	else if (dice % 2)
+	  args->map->insert(key, i);
+	else
+	  args->map->erase(key);
+  }
+  return 0;
+}
+
+template<class Map>
+static double
+run_skiplist_scaling(int threads, int total_ops) {
+  Map *map = new Map;
+  std::vector<skiplist_scaling_args<Map> > args(threads);
+  for (int i = 0; i < 65536; i += 2)
+	map->insert(i, i);
+  for (int t = 0; t < threads; t++) {
+	args[t].map = map;
+	args[t].thread = t;
+	args[t].ops = total_ops / threads;
+	args[t].found = 0;
+  }
+  double start = wall_ms();
+  run_threads(skiplist_scaling_thread<Map>, &args[0], sizeof(args[0]), threads);
+  double end = wall_ms();
+  delete map;
+  return end - start;
+}
+
+void
+test_concurrent_skiplist_map() {
+  std::cout << "**********CONCURRENT SKIPLIST MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_map_type stl_map;
+	ft_skiplist_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE";
+
+	stl_map_type stl_map;
+	ft_skiplist_map ft_map;
+
+	for (int i = 0; i < 1000; i++) {
+	  int key = (i * 7919) % 1009;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+	for (int key = 0; key < 1009; key += 5) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	std::cout << "STL Map insert (1) = " << stl_map.insert(std::make_pair(1, 5)).second << std::endl;
+	std::cout << "FT Skip List Map insert (1) = " << ft_map.insert(ft::make_pair(1, 5)).second << std::endl;
+	std::cout << "STL Map erase (5) = " << stl_map.erase(5) << std::endl;
+	std::cout << "FT Skip List Map erase (5) = " << ft_map.erase(5) << std::endl;
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "FIND / LOWER BOUND";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Map find (8) = " << stl_map.find(8)->second << std::endl;
+	std::cout << "FT Skip List Map find (8) = " << ft_map.find(8)->second << std::endl;
+	std::cout << "STL Map find (10) is end = " << (stl_map.find(10) == stl_map.end()) << std::endl;
+	std::cout << "FT Skip List Map find (10) is end = " << (ft_map.find(10) == ft_map.end()) << std::endl;
+	std::cout << "STL Map lower bound (10) = " << stl_map.lower_bound(10)->first << std::endl;
+	std::cout << "FT Skip List Map lower bound (10) = " << ft_map.lower_bound(10)->first << std::endl;
+	std::cout << "FT Skip List Map lower bound (2000) is end = " << (ft_map.lower_bound(2000) == ft_map.end()) << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "CONCURRENT WRITERS";
+
+	const int threads = 8;
+	stl_map_type stl_map;
+	ft_skiplist_map ft_map;
+	skiplist_writer_args args[threads];
+
+	for (int t = 0; t < threads; t++) {
+	  args[t].map = &ft_map;
+	  args[t].thread = t;
+	  args[t].threads = threads;
+	  args[t].lost_writes = 0;
+	}
+	run_threads(skiplist_writer_thread, args, sizeof(args[0]), threads);
+	int lost_writes = 0;
+	for (int t = 0; t < threads; t++) {
+	  lost_writes += args[t].lost_writes;
+	  for (int i = 0; i < 2000; i++) {
+		if (i % 3)
+		  stl_map[i * threads + t] = i;
+	  }
+	}
+
+	std::cout << "Writes not seen by their own thread: " << lost_writes << std::endl;
+	printValues(stl_map, ft_map, testName);
+
+	testName = "CONTENDED KEYS";
+
+	ft_skiplist_map contended;
+	for (int t = 0; t < threads; t++) {
+	  args[t].map = &contended;
+	  args[t].lost_writes = 0;
+	}
+	run_threads(skiplist_contended_thread, args, sizeof(args[0]), threads);
+	int bad_walks = 0;
+	for (int t = 0; t < threads; t++)
+	  bad_walks += args[t].lost_writes;
+	size_t walked = 0;
+	for (ft_skiplist_map::const_iterator it = contended.begin(); it != contended.end(); ++it)
+	  walked++;
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Out of order elements seen while walking: " << bad_walks << std::endl;
+	std::cout << "Result of size comparison: " << is_equal(walked, contended.size()) << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "THREAD SCALING SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int total_ops = 256000;
+
+	//одна и та же работа на 1..64 потоках
+	for (int threads = 1; threads <= 64; threads *= 2) {
+	  double time_taken_locked = run_skiplist_scaling<skiplist_baseline_map>(threads, total_ops);
+	  double time_taken_skiplist = run_skiplist_scaling<skiplist_adapter>(threads, total_ops);
+	  std::cout << std::setfill(' ') << std::setw(2) << std::right << threads << std::left
+				<< " threads: mutex map time is " << time_taken_locked
+				<< " ms, skip list map time is " << time_taken_skiplist << " ms" << std::endl;
+	}
+	std::cout << "\n";
+  }
+}
@@ -0,0 +1,390 @@
+#include "../src/concurrent_stack.hpp"
+#include "../src/stack.hpp"
+#include <stack>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include "test_threads.hpp"
+
+typedef ft::concurrent_stack<int> ft_concurrent_stack;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+// Its assignment throws while stack_fail_copies is set, as pop() assigns
+// the popped value out.
+static bool stack_fail_copies = false;
+
+struct stack_fragile {
+  int value;
+
+  stack_fragile(int value = 0) : value(value) {}
+
+  stack_fragile &operator=(const stack_fragile &other) {
+	if (stack_fail_copies)
+	  throw std::runtime_error("copy failed");
+	value = other.value;
+	return *this;
+  }
+};
+
+// Pops everything into out, top first, and pushes it back.
+static void
+drain_and_restore(ft_concurrent_stack &ft_stack, std::vector<int> &out) {
+  int value;
+  while (ft_stack.pop(value))
+	out.push_back(value);
+  for (size_t i = out.size(); i > 0; i--)
+	ft_stack.push(out[i - 1]);
+}
+
+static std::string
+is_equal_content(std::stack<int> stl_stack, const std::vector<int> &ft_values) {
+  for (size_t i = 0; i < ft_values.size(); i++, stl_stack.pop()) {
+	if (stl_stack.empty() || stl_stack.top() != ft_values[i])
+	  return ("NOT EQUAL");
+  }
+  if (!stl_stack.empty())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(std::stack<int> &stl_stack, ft_concurrent_stack &ft_stack, const std::string &testName) {
+  std::vector<int> ft_values;
+  drain_and_restore(ft_stack, ft_values);
+
+  //stl_stack
+  std::string stl_empty = ((stl_stack.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_stack.size();
+
+  //ft_concurrent_stack
+  std::string ft_empty = ((ft_stack.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_values.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_stack, ft_values);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Stack";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Conc. Stack";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+static const int mpmc_values = 5000;
+
+typedef ft::concurrent_stack<int, 16> ft_elimination_stack;
+
+// ft::stack behind one mutex: what concurrent_stack replaces.
+struct stack_mutex_stack {
+  ft::stack<int> stack;
+  ft::mutex lock;
+
+  void push(int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	stack.push(value);
+  }
+
+  bool pop(int &value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	if (stack.empty())
+	  return false;
+	value = stack.top();
+	stack.pop();
+	return true;
+  }
+};
+
+// A concurrent stack that every thread uses through its own buffer.
+struct stack_buffered_stack {
+  ft_concurrent_stack stack;
+};
+
+// What a thread pushes and pops through.
+template<class Stack>
+struct stack_handle {
+  Stack &stack;
+
+  explicit stack_handle(Stack &s) : stack(s) {}
+  void push(int value) { stack.push(value); }
+  bool pop(int &value) { return stack.pop(value); }
+};
+
+template<>
+struct stack_handle<stack_buffered_stack> {
+  ft_concurrent_stack::buffer buffer;
+
+  explicit stack_handle(stack_buffered_stack &s) : buffer(s.stack, 32) {}
+  void push(int value) { buffer.push(value); }
+  bool pop(int &value) { return buffer.pop(value); }
+};
+
+template<class Stack>
+struct stack_mpmc_args {
+  Stack *stack;
+  int thread;
+  std::vector<int> popped;
+};
+
+// Each thread pushes its own values, popping one after every other push;
+// what it pops may come from any thread.
+template<class Stack>
+static void *
+stack_mpmc_thread(void *arg) {
+  stack_mpmc_args<Stack> *args = static_cast<stack_mpmc_args<Stack> *>(arg);
+  stack_handle<Stack> handle(*args->stack);
+  int value;
+  for (int i = 0; i < mpmc_values; i++) {
+	handle.push(args->thread * mpmc_values + i);
+	if (i % 2 && handle.pop(value))
+	  args->popped.push_back(value);
+  }
+  return 0;
+}
+
+// Every value pushed must come out exactly once, during the run or after.
+template<class Stack, class Remaining>
+static void
+run_stack_mpmc(Stack &stack, Remaining &remaining, const std::string &testName) {
+  const int threads = 8;
+  stack_mpmc_args<Stack> args[threads];
+
+  for (int t = 0; t < threads; t++) {
+	args[t].stack = &stack;
+	args[t].thread = t;
+  }
+  run_threads(stack_mpmc_thread<Stack>, args, sizeof(args[0]), threads);
+
+  //каждое значение должно выйти ровно один раз
+  std::vector<int> seen(threads * mpmc_values, 0);
+  int value;
+  while (remaining.pop(value))
+	seen[value]++;
+  for (int t = 0; t < threads; t++) {
+	for (size_t i = 0; i < args[t].popped.size(); i++)
+	  seen[args[t].popped[i]]++;
+  }
+  int lost = 0, duplicated = 0;
+  for (size_t i = 0; i < seen.size(); i++) {
+	lost += seen[i] == 0;
+	duplicated += seen[i] > 1;
+  }
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << "Lost values: " << lost << ", duplicated values: " << duplicated << std::endl;
+  std::cout << "Result of value accounting: " << is_equal(lost + duplicated, 0) << std::endl;
+  std::cout << "\n";
+}
+
+template<class Stack>
+struct stack_scaling_args {
+  Stack *stack;
+  int ops;
+  long popped;
+};
+
+// Pairs of pushes and pops: the stack stays shallow and every operation
+// goes through the top.
+template<class Stack>
+static void *
+stack_scaling_thread(void *arg) {
+  stack_scaling_args<Stack> *args = static_cast<stack_scaling_args<Stack> *>(arg);
+  stack_handle<Stack> handle(*args->stack);
+  int value;
+  for (int i = 0; i < args->ops; i += 2) {
+	handle.push(i);
+	args->popped += handle.pop(value);
+  }
+  return 0;
+}
+
+template<class Stack>
+static double
+run_stack_scaling(int threads, int total_ops) {
+  Stack stack;
+  std::vector<stack_scaling_args<Stack> > args(threads);
+  for (int t = 0; t < threads; t++) {
+	args[t].stack = &stack;
+	args[t].ops = total_ops / threads;
+	args[t].popped = 0;
+  }
+  double start = wall_ms();
+  run_threads(stack_scaling_thread<Stack>, &args[0], sizeof(args[0]), threads);
+  double end = wall_ms();
+  return end - start;
+}
+
+void
+test_concurrent_stack() {
+  std::cout << "**********CONCURRENT STACK TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	std::stack<int> stl_stack;
+	ft_concurrent_stack ft_stack;
+
+	printValues(stl_stack, ft_stack, testName);
+  }
+  {
+	testName = "PUSH / POP";
+
+	std::stack<int> stl_stack;
+	ft_concurrent_stack ft_stack;
+	int stl_value, ft_value;
+	bool ft_popped = true;
+
+	for (int i = 0; i < 1000; i++) {
+	  stl_stack.push(i * 3);
+	  ft_stack.push(i * 3);
+	}
+	for (int i = 0; i < 300; i++) {
+	  stl_value = stl_stack.top();
+	  stl_stack.pop();
+	  ft_popped = ft_popped && ft_stack.pop(ft_value) && ft_value == stl_value;
+	}
+	for (int i = 0; i < 50; i++) {
+	  stl_stack.push(-i);
+	  ft_stack.push(-i);
+	}
+
+	std::cout << "Result of pop comparison: " << is_equal(ft_popped, true) << std::endl;
+	printValues(stl_stack, ft_stack, testName);
+
+	testName = "POP UNTIL EMPTY";
+
+	while (!stl_stack.empty())
+	  stl_stack.pop();
+	while (ft_stack.pop(ft_value)) {}
+	std::cout << "Result of pop on empty: " << is_equal(ft_stack.pop(ft_value), false) << std::endl;
+	printValues(stl_stack, ft_stack, testName);
+
+	testName = "RESERVE";
+
+	ft_stack.reserve(100000);
+	for (int i = 0; i < 100000; i++) {
+	  stl_stack.push(i);
+	  ft_stack.push(i);
+	}
+	printValues(stl_stack, ft_stack, testName);
+  }
+  {
+	testName = "BUFFER FLUSH";
+
+	std::stack<int> stl_stack;
+	ft_concurrent_stack ft_stack;
+	{
+	  ft_concurrent_stack::buffer buffer(ft_stack, 32);
+	  int value = 0;
+
+	  //до сброса буфера другие потоки ничего не видят
+	  for (int i = 0; i < 10; i++)
+		buffer.push(i);
+	  std::cout << "Result of empty before flush: " << is_equal(ft_stack.empty(), true) << std::endl;
+	  buffer.flush();
+	  for (int i = 0; i < 10; i++)
+		stl_stack.push(i);
+	  printValues(stl_stack, ft_stack, testName);
+
+	  testName = "BUFFER BATCHES";
+
+	  for (int i = 10; i < 100; i++) {
+		stl_stack.push(i);
+		buffer.push(i);
+	  }
+	  buffer.pop(value);
+	  stl_stack.pop();
+	  std::cout << "Result of buffer pop (newest first): " << is_equal(value, 99) << std::endl;
+	}
+	printValues(stl_stack, ft_stack, testName);
+  }
+  {
+	testName = "POP WITH A THROWING COPY";
+
+	//элемент не теряется, если копирование при pop бросает исключение
+	ft::concurrent_stack<stack_fragile> fragile_stack;
+	stack_fragile out;
+	std::string stack_thrown = "no", buffer_thrown = "no";
+	for (int i = 1; i <= 3; i++)
+	  fragile_stack.push(stack_fragile(i));
+	stack_fail_copies = true;
+	try {
+	  fragile_stack.pop(out);
+	} catch (std::runtime_error &) {
+	  stack_thrown = "yes";
+	}
+	stack_fail_copies = false;
+	bool kept = fragile_stack.pop(out) && out.value == 3;
+	{
+	  ft::concurrent_stack<stack_fragile>::buffer buffer(fragile_stack, 4);
+	  stack_fail_copies = true;
+	  try {
+		buffer.pop(out);
+	  } catch (std::runtime_error &) {
+		buffer_thrown = "yes";
+	  }
+	  stack_fail_copies = false;
+	  kept = kept && buffer.pop(out) && out.value == 2;
+	  kept = kept && buffer.pop(out) && out.value == 1 && !buffer.pop(out);
+	}
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Pop throws: " << stack_thrown << ", buffer pop throws: " << buffer_thrown << std::endl;
+	std::cout << "Result of elements kept: " << is_equal(kept, true) << std::endl;
+	std::cout << "\n";
+  }
+  {
+	ft_concurrent_stack ft_stack;
+	run_stack_mpmc(ft_stack, ft_stack, "MULTIPLE PRODUCERS AND CONSUMERS");
+
+	ft_elimination_stack ft_elimination;
+	run_stack_mpmc(ft_elimination, ft_elimination, "MULTIPLE PRODUCERS AND CONSUMERS (ELIMINATION)");
+
+	stack_buffered_stack ft_buffered;
+	run_stack_mpmc(ft_buffered, ft_buffered.stack, "MULTIPLE PRODUCERS AND CONSUMERS (BUFFERS)");
+  }
+  {
+	testName = "THREAD SCALING SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int total_ops = 1024000;
+
+	//одна и та же работа на 1..64 потоках
+	for (int threads = 1; threads <= 64; threads *= 2) {
+	  double time_taken_locked = run_stack_scaling<stack_mutex_stack>(threads, total_ops);
+	  double time_taken_concurrent = run_stack_scaling<ft_concurrent_stack>(threads, total_ops);
+	  double time_taken_elimination = run_stack_scaling<ft_elimination_stack>(threads, total_ops);
+	  double time_taken_buffered = run_stack_scaling<stack_buffered_stack>(threads, total_ops);
+	  std::cout << std::setfill(' ') << std::setw(2) << std::right << threads << std::left << " threads: mutex stack time is "
+				<< time_taken_locked << " ms, concurrent stack time is " << time_taken_concurrent
+				<< " ms, elimination time is " << time_taken_elimination << " ms, buffered time is "
+				<< time_taken_buffered << " ms" << std::endl;
+	}
+	std::cout << "\n";
+  }
+}
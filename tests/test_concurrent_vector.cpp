@@ -0,0 +1,393 @@
+#include "../src/concurrent_vector.hpp"
+#include "../src/vector.hpp"
+#include "../utils/lock.hpp"
+#include <vector>
+#include <new>
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+#include <pthread.h>
+#include "test_threads.hpp"
+
+typedef std::vector<int> stl_vector_type;
+typedef ft::concurrent_vector<int> ft_concurrent_vector;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+// No default constructor: push_back must never need one.
+struct vector_point {
+  int x;
+  int y;
+
+  vector_point(int x, int y) : x(x), y(y) {}
+};
+
+// Throws bad_alloc once when told to, as a segment allocation might. The
+// flag is shared by every rebound copy.
+static bool vector_fail_next_allocation = false;
+
+template<class T>
+struct vector_failing_allocator : std::allocator<T> {
+  template<class U>
+  struct rebind { typedef vector_failing_allocator<U> other; };
+
+  vector_failing_allocator() {}
+
+  template<class U>
+  vector_failing_allocator(const vector_failing_allocator<U> &) {}
+
+  T *allocate(size_t n) {
+	if (vector_fail_next_allocation) {
+	  vector_fail_next_allocation = false;
+	  throw std::bad_alloc();
+	}
+	return std::allocator<T>::allocate(n);
+  }
+};
+
+static std::string
+is_equal_content(const stl_vector_type &stl_vector, const ft_concurrent_vector &ft_vector) {
+  ft_concurrent_vector::const_iterator ft_it = ft_vector.begin();
+  for (stl_vector_type::const_iterator stl_it = stl_vector.begin(); stl_it != stl_vector.end(); stl_it++, ft_it++) {
+	if (ft_it == ft_vector.end() || *ft_it != *stl_it)
+	  return ("NOT EQUAL");
+  }
+  if (ft_it != ft_vector.end())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_vector_type &stl_vector, ft_concurrent_vector &ft_vector, const std::string &testName) {
+  //stl vector
+  std::string stl_empty = ((stl_vector.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_vector.size();
+
+  //ft concurrent vector
+  std::string ft_empty = ((ft_vector.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_vector.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_vector, ft_vector);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Vector";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Conc. Vector";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+static const int append_writers = 8;
+static const int append_values = 10000;
+
+struct vector_append_args {
+  ft_concurrent_vector *vector;
+  int thread;
+  int misplaced;
+};
+
+// Value t * append_values + i is the i-th append of thread t.
+static void *
+vector_append_thread(void *arg) {
+  vector_append_args *args = static_cast<vector_append_args *>(arg);
+  for (int i = 0; i < append_values; i++) {
+	int value = args->thread * append_values + i;
+	if (*args->vector->push_back(value) != value)
+	  args->misplaced++;
+  }
+  return 0;
+}
+
+struct vector_reader_args {
+  ft_concurrent_vector *vector;
+  volatile int *done;
+  int scans;
+  int torn_reads;
+};
+
+// Every index below size() must hold a whole element, and each writer's
+// elements must appear in the order it appended them.
+static void *
+vector_reader_thread(void *arg) {
+  vector_reader_args *args = static_cast<vector_reader_args *>(arg);
+  while (!__atomic_load_n(args->done, __ATOMIC_ACQUIRE)) {
+	std::vector<int> last(append_writers, -1);
+	size_t size = args->vector->size();
+	for (size_t i = 0; i < size; i++) {
+	  int value = (*args->vector)[i];
+	  int writer = value / append_values;
+	  if (value < 0 || writer >= append_writers || value % append_values <= last[writer])
+		args->torn_reads++;
+	  else
+		last[writer] = value % append_values;
+	}
+	args->scans++;
+  }
+  return 0;
+}
+
+// ft::vector behind one mutex: appends only.
+struct vector_mutex_vector {
+  ft::vector<int> vector;
+  ft::mutex lock;
+
+  void push_back(int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	vector.push_back(value);
+  }
+};
+
+template<class Vector>
+struct vector_scaling_args {
+  Vector *vector;
+  int count;
+};
+
+template<class Vector>
+static void *
+vector_scaling_thread(void *arg) {
+  vector_scaling_args<Vector> *args = static_cast<vector_scaling_args<Vector> *>(arg);
+  for (int i = 0; i < args->count; i++)
+	args->vector->push_back(i);
+  return 0;
+}
+
+template<class Vector>
+static double
+run_vector_scaling(int threads, int total) {
+  Vector vector;
+  std::vector<vector_scaling_args<Vector> > args(threads);
+  for (int t = 0; t < threads; t++) {
+	args[t].vector = &vector;
+	args[t].count = total / threads;
+  }
+  double start = wall_ms();
+  run_threads(vector_scaling_thread<Vector>, &args[0], sizeof(args[0]), threads);
+  double end = wall_ms();
+  return end - start;
+}
+
+void
+test_concurrent_vector() {
+  std::cout << "**********CONCURRENT VECTOR TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_vector_type stl_vector;
+	ft_concurrent_vector ft_vector;
+
+	printValues(stl_vector, ft_vector, testName);
+  }
+  {
+	testName = "PUSH_BACK";
+
+	stl_vector_type stl_vector;
+	ft_concurrent_vector ft_vector;
+
+	for (int i = 0; i < 1000; i++) {
+	  stl_vector.push_back(i * 7 - 300);
+	  ft_vector.push_back(i * 7 - 300);
+	}
+
+	printValues(stl_vector, ft_vector, testName);
+
+	testName = "AT / OPERATOR[] / FRONT / BACK";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Vector at (10) = " << stl_vector.at(10) << ", [999] = " << stl_vector[999] << std::endl;
+	std::cout << "FT Concurrent Vector at (10) = " << ft_vector.at(10) << ", [999] = " << ft_vector[999] << std::endl;
+	std::cout << "STL Vector front = " << stl_vector.front() << ", back = " << stl_vector.back() << std::endl;
+	std::cout << "FT Concurrent Vector front = " << ft_vector.front() << ", back = " << ft_vector.back() << std::endl;
+	std::string thrown = "no";
+	try {
+	  ft_vector.at(1000);
+	} catch (std::out_of_range &) {
+	  thrown = "yes";
+	}
+	std::cout << "FT Concurrent Vector at (1000) throws: " << thrown << std::endl;
+	std::cout << "\n";
+
+	testName = "ITERATORS";
+
+	ft_concurrent_vector::iterator it = ft_vector.begin() + 500;
+	ft_concurrent_vector::const_iterator cit = it;
+	ft_concurrent_vector::reverse_iterator rit = ft_vector.rbegin();
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Result of end - begin: " << is_equal((size_t)(ft_vector.end() - ft_vector.begin()), stl_vector.size()) << std::endl;
+	std::cout << "Result of *(begin + 500): " << is_equal(*cit, stl_vector[500]) << std::endl;
+	std::cout << "Result of it[-3]: " << is_equal(it[-3], stl_vector[497]) << std::endl;
+	std::cout << "Result of *rbegin: " << is_equal(*rit, stl_vector.back()) << std::endl;
+	*it = 12345;
+	stl_vector[500] = 12345;
+	std::cout << "\n";
+
+	printValues(stl_vector, ft_vector, testName);
+  }
+  {
+	testName = "STABLE REFERENCES";
+
+	ft_concurrent_vector ft_vector;
+	ft_vector.push_back(42);
+	const int *first = &ft_vector[0];
+	ft_concurrent_vector::iterator it = ft_vector.push_back(43);
+
+	//элементы не перемещаются при росте
+	for (int i = 0; i < 100000; i++)
+	  ft_vector.push_back(i);
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Result of first element address: " << is_equal(first, (const int *)&ft_vector[0]) << std::endl;
+	std::cout << "Result of iterator after growth: " << is_equal(*it, 43) << std::endl;
+	std::cout << "\n";
+
+	testName = "ELEMENTS WITHOUT A DEFAULT CONSTRUCTOR";
+
+	ft::concurrent_vector<vector_point> points;
+	for (int i = 0; i < 1000; i++)
+	  points.push_back(vector_point(i, -i));
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Result of size: " << is_equal(points.size(), (size_t)1000) << std::endl;
+	std::cout << "Result of [700]: " << is_equal(points[700].x - points[700].y, 1400) << std::endl;
+	std::cout << "\n";
+
+	testName = "SEGMENT ALLOCATION FAILURE";
+
+	//неудачное выделение сегмента не должно останавливать size()
+	ft::concurrent_vector<int, vector_failing_allocator<int> > failing;
+	for (int i = 0; i < 64; i++)
+	  failing.push_back(i);
+	std::string alloc_thrown = "no";
+	vector_fail_next_allocation = true;
+	try {
+	  failing.push_back(64);
+	} catch (std::bad_alloc &) {
+	  alloc_thrown = "yes";
+	}
+	failing.push_back(65);
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Push into a missing segment throws: " << alloc_thrown << std::endl;
+	std::cout << "Result of size after the failure: " << is_equal(failing.size(), (size_t)65) << std::endl;
+	std::cout << "Result of [64]: " << is_equal(failing[64], 65) << std::endl;
+	std::cout << "\n";
+
+	testName = "RESERVE / CLEAR";
+
+	stl_vector_type stl_vector;
+	ft_concurrent_vector reserved;
+	reserved.reserve(5000);
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Result of capacity after reserve: " << is_equal(reserved.capacity() >= 5000, true) << std::endl;
+	ft_vector.clear();
+	printValues(stl_vector, ft_vector, testName);
+  }
+  {
+	testName = "CONCURRENT APPENDS";
+
+	const int readers = 2;
+	ft_concurrent_vector ft_vector;
+	vector_append_args writer_args[append_writers];
+	vector_reader_args reader_args[readers];
+	pthread_t reader_threads[readers];
+	volatile int done = 0;
+
+	for (int t = 0; t < readers; t++) {
+	  reader_args[t].vector = &ft_vector;
+	  reader_args[t].done = &done;
+	  reader_args[t].scans = 0;
+	  reader_args[t].torn_reads = 0;
+	  pthread_create(&reader_threads[t], 0, vector_reader_thread, &reader_args[t]);
+	}
+	for (int t = 0; t < append_writers; t++) {
+	  writer_args[t].vector = &ft_vector;
+	  writer_args[t].thread = t;
+	  writer_args[t].misplaced = 0;
+	}
+	run_threads(vector_append_thread, writer_args, sizeof(writer_args[0]), append_writers);
+	__atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+	int torn_reads = 0, misplaced = 0;
+	for (int t = 0; t < readers; t++) {
+	  pthread_join(reader_threads[t], 0);
+	  torn_reads += reader_args[t].torn_reads;
+	}
+	for (int t = 0; t < append_writers; t++)
+	  misplaced += writer_args[t].misplaced;
+
+	//каждое значение ровно один раз
+	std::vector<int> seen(append_writers * append_values, 0);
+	for (ft_concurrent_vector::const_iterator it = ft_vector.begin(); it != ft_vector.end(); ++it)
+	  seen[*it]++;
+	int lost = 0;
+	for (size_t i = 0; i < seen.size(); i++)
+	  lost += seen[i] != 1;
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Size = " << ft_vector.size() << std::endl;
+	std::cout << "Torn reads: " << torn_reads << ", misplaced appends: " << misplaced << ", lost values: " << lost << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "THREAD SCALING SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int total = 1024000;
+
+	//одна и та же работа на 1..64 потоках
+	for (int threads = 1; threads <= 64; threads *= 2) {
+	  double time_taken_locked = run_vector_scaling<vector_mutex_vector>(threads, total);
+	  double time_taken_concurrent = run_vector_scaling<ft_concurrent_vector>(threads, total);
+	  std::cout << std::setfill(' ') << std::setw(2) << std::right << threads << std::left << " threads: mutex vector append time is "
+				<< time_taken_locked << " ms, concurrent vector append time is " << time_taken_concurrent << " ms" << std::endl;
+	}
+
+	//чтение по индексу
+	time_t start, end;
+	double time_taken_ft, time_taken_concurrent;
+	ft::vector<int> ft_vector;
+	ft_concurrent_vector concurrent;
+	long sum_ft = 0, sum_concurrent = 0;
+	for (int i = 0; i < total; i++) {
+	  ft_vector.push_back(i);
+	  concurrent.push_back(i);
+	}
+	start = clock();
+	for (int round = 0; round < 10; round++)
+	  for (int i = 0; i < total; i++)
+		sum_ft += ft_vector[i];
+	end = clock();
+	time_taken_ft = end - start;
+	start = clock();
+	for (int round = 0; round < 10; round++)
+	  for (int i = 0; i < total; i++)
+		sum_concurrent += concurrent[i];
+	end = clock();
+	time_taken_concurrent = end - start;
+	std::cout << "FT vector operator[] time is " << time_taken_ft << " ms" << std::endl;
+	std::cout << "FT concurrent vector operator[] time is " << time_taken_concurrent << " ms" << std::endl;
+	std::cout << "Result of sum comparison: " << is_equal(sum_ft, sum_concurrent) << std::endl;
+	std::cout << "\n";
+  }
+}
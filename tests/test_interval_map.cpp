@@ -0,0 +1,245 @@
+#include "../src/interval_map.hpp"
+#include <vector>
+#include <map>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <ctime>
+
+typedef std::map<std::pair<int, int>, int> stl_interval_map;
+typedef ft::interval_map<int, int> ft_interval_map;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_interval_map &stl_map, const ft_interval_map &ft_map) {
+  ft_interval_map::const_iterator ft_it;
+  stl_interval_map::const_iterator stl_it;
+  if (ft_map.size() != stl_map.size())
+	return ("NOT EQUAL");
+  stl_it = stl_map.begin();
+  for (ft_it = ft_map.begin(); ft_it != ft_map.end(); ft_it++) {
+	if ((*ft_it).first.low != (*stl_it).first.first || (*ft_it).first.high != (*stl_it).first.second
+		|| (*ft_it).second != (*stl_it).second)
+	  return ("NOT EQUAL");
+	stl_it++;
+  }
+  return ("EQUAL");
+}
+
+// Comparator with state: the default-constructed one orders points the
+// other way, so a map that lost its comparator would answer wrongly.
+struct point_order {
+  bool reversed;
+
+  point_order(bool reversed = false) : reversed(reversed) {}
+
+  bool operator()(int lhs, int rhs) const { return reversed ? rhs < lhs : lhs < rhs; }
+};
+
+typedef ft::interval_map<int, int, point_order> ft_reversed_interval_map;
+
+// Linear filter the interval map is measured against.
+static void
+stl_overlapping(const stl_interval_map &stl_map, int low, int high,
+				std::vector<stl_interval_map::const_iterator> &out) {
+  for (stl_interval_map::const_iterator it = stl_map.begin(); it != stl_map.end(); ++it) {
+	if (low < high && it->first.first < high && low < it->first.second && it->first.first < it->first.second)
+	  out.push_back(it);
+  }
+}
+
+static std::string
+is_equal_result(const std::vector<stl_interval_map::const_iterator> &stl_result,
+				const std::vector<ft_interval_map::const_iterator> &ft_result) {
+  if (stl_result.size() != ft_result.size())
+	return ("NOT EQUAL");
+  for (size_t i = 0; i < stl_result.size(); i++) {
+	if (stl_result[i]->first.first != ft_result[i]->first.low || stl_result[i]->first.second != ft_result[i]->first.high)
+	  return ("NOT EQUAL");
+  }
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_interval_map &stl_map, ft_interval_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft interval map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Interval";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+void
+test_interval_map() {
+  std::cout << "**********INTERVAL MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_interval_map stl_map;
+	ft_interval_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE MANY";
+
+	stl_interval_map stl_map;
+	ft_interval_map ft_map;
+
+	for (int i = 0; i < 5000; i++) {
+	  int low = (i * 7919) % 10007;
+	  int high = low + 1 + (i * 31) % 97;
+	  stl_map.insert(std::make_pair(std::make_pair(low, high), i));
+	  ft_map.insert(low, high, i);
+	}
+	for (int i = 0; i < 5000; i += 3) {
+	  int low = (i * 7919) % 10007;
+	  int high = low + 1 + (i * 31) % 97;
+	  stl_map.erase(std::make_pair(low, high));
+	  ft_map.erase(ft::make_interval(low, high));
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "OVERLAP QUERY";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int queries[][2] = {{0, 10}, {500, 520}, {5000, 5001}, {9990, 20000}, {300, 300}, {-50, 0}};
+	for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+	  std::vector<stl_interval_map::const_iterator> stl_result;
+	  std::vector<ft_interval_map::const_iterator> ft_result;
+	  stl_overlapping(stl_map, queries[q][0], queries[q][1], stl_result);
+	  ft_map.overlapping(queries[q][0], queries[q][1], std::back_inserter(ft_result));
+	  std::cout << "[" << queries[q][0] << ", " << queries[q][1] << "): STL " << stl_result.size()
+				<< ", FT " << ft_result.size() << ", " << is_equal_result(stl_result, ft_result) << std::endl;
+	}
+	std::cout << "\n";
+
+	testName = "STABBING QUERY";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int points[] = {0, 42, 5000, 10006, 10200};
+	for (size_t p = 0; p < sizeof(points) / sizeof(points[0]); p++) {
+	  std::vector<stl_interval_map::const_iterator> stl_result;
+	  std::vector<ft_interval_map::const_iterator> ft_result;
+	  stl_overlapping(stl_map, points[p], points[p] + 1, stl_result);
+	  ft_map.stabbing(points[p], std::back_inserter(ft_result));
+	  std::cout << points[p] << ": STL " << stl_result.size() << ", FT " << ft_result.size()
+				<< ", " << is_equal_result(stl_result, ft_result) << std::endl;
+	}
+	std::cout << "\n";
+
+	testName = "QUERIES WITH A STATEFUL COMPARATOR";
+
+	//точки в обратном порядке: [-high, -low) против [low, high)
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	ft_reversed_interval_map reversed_map(point_order(true));
+	for (stl_interval_map::const_iterator it = stl_map.begin(); it != stl_map.end(); ++it)
+	  reversed_map.insert(-it->first.first, -it->first.second, it->second);
+	const ft_reversed_interval_map &const_reversed_map = reversed_map;
+	for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+	  std::vector<stl_interval_map::const_iterator> stl_result;
+	  std::vector<ft_reversed_interval_map::const_iterator> ft_result;
+	  stl_overlapping(stl_map, queries[q][0], queries[q][1], stl_result);
+	  const_reversed_map.overlapping(-queries[q][0], -queries[q][1], std::back_inserter(ft_result));
+	  std::cout << "[" << queries[q][0] << ", " << queries[q][1] << "): STL " << stl_result.size()
+				<< ", FT " << ft_result.size() << ", " << is_equal(stl_result.size(), ft_result.size()) << std::endl;
+	}
+	for (size_t p = 0; p < sizeof(points) / sizeof(points[0]); p++) {
+	  std::vector<stl_interval_map::const_iterator> stl_result;
+	  std::vector<ft_reversed_interval_map::const_iterator> ft_result;
+	  stl_overlapping(stl_map, points[p], points[p] + 1, stl_result);
+	  const_reversed_map.stabbing(-points[p], std::back_inserter(ft_result));
+	  std::cout << points[p] << ": STL " << stl_result.size() << ", FT " << ft_result.size()
+				<< ", " << is_equal(stl_result.size(), ft_result.size()) << std::endl;
+	}
+	std::cout << "Count of a present key: " << const_reversed_map.count(ft::make_interval(-stl_map.begin()->first.first,
+				-stl_map.begin()->first.second)) << std::endl;
+	std::cout << "\n";
+
+	testName = "CLEAR";
+
+	stl_map.clear();
+	ft_map.clear();
+
+	printValues(stl_map, ft_map, testName);
+  }
+    {
+        testName = "SPEED TEST";
+        std::cout << "\n";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+        time_t start, end;
+        double time_taken_linear, time_taken_tree;
+        const int count = 100000;
+        size_t found_linear = 0, found_tree = 0;
+
+        stl_interval_map stl_map;
+        ft_interval_map ft_map;
+        for (int i = 0; i < count; i++) {
+            int low = (int)(((long)i * 48271) % 1000003) * 16;
+            int high = low + 64 + (i % 8) * 64;
+            stl_map.insert(std::make_pair(std::make_pair(low, high), i));
+            ft_map.insert(low, high, i);
+        }
+
+        //поиск пересечений
+        start = clock();
+        for (int i = 0; i < 500; i++) {
+            std::vector<stl_interval_map::const_iterator> result;
+            stl_overlapping(stl_map, i * 32000, i * 32000 + 4096, result);
+            found_linear += result.size();
+        }
+        end = clock();
+        time_taken_linear = end - start;
+        std::cout << "Linear filter overlap time is " << time_taken_linear << " ms" << std::endl;
+
+        start = clock();
+        for (int i = 0; i < 500; i++) {
+            std::vector<ft_interval_map::const_iterator> result;
+            ft_map.overlapping(i * 32000, i * 32000 + 4096, std::back_inserter(result));
+            found_tree += result.size();
+        }
+        end = clock();
+        time_taken_tree = end - start;
+        std::cout << "FT interval_map overlap time is " << time_taken_tree << " ms" << std::endl;
+        std::cout << "Result of found count comparison: " << is_equal(found_linear, found_tree) << std::endl;
+        std::cout << "FT interval_map overlap faster in " << time_taken_linear / time_taken_tree << " times";
+        std::cout << "\n\n";
+    }
+}
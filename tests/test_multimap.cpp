@@ -0,0 +1,257 @@
+#include "../src/multimap.hpp"
+#include "../src/vector.hpp"
+#include <map>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <ctime>
+
+typedef std::multimap<int, int> stl_multimap;
+typedef ft::multimap<int, int> ft_multimap;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+template<class Tree>
+static std::string
+is_equal_content(const stl_multimap &stl_map, const ft::multimap<int, int, ft::less<int>,
+				 std::allocator<ft::pair<const int, int> >, Tree> &ft_map) {
+  typename ft::multimap<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, Tree>::const_iterator ft_it;
+  stl_multimap::const_iterator stl_it;
+  if (ft_map.size() != stl_map.size())
+	return ("NOT EQUAL");
+  stl_it = stl_map.begin();
+  for (ft_it = ft_map.begin(); ft_it != ft_map.end(); ft_it++) {
+	if ((*ft_it).first != (*stl_it).first || (*ft_it).second != (*stl_it).second)
+	  return ("NOT EQUAL");
+	stl_it++;
+  }
+  return ("EQUAL");
+}
+
+template<class Tree>
+static void
+printValues(stl_multimap &stl_map, ft::multimap<int, int, ft::less<int>,
+			std::allocator<ft::pair<const int, int> >, Tree> &ft_map, const std::string &testName) {
+  //stl multimap
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft multimap
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Multimap";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Multimap";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+void
+test_multimap() {
+  std::cout << "**********MULTIMAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_multimap stl_map;
+	ft_multimap ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT DUPLICATES";
+
+	stl_multimap stl_map;
+	ft_multimap ft_map;
+
+	for (int i = 0; i < 3000; i++) {
+	  int key = (i * 7919) % 101;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "COUNT / EQUAL RANGE";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int keys[] = {-1, 0, 42, 100, 101};
+	for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++) {
+	  std::pair<stl_multimap::iterator, stl_multimap::iterator> stl_range = stl_map.equal_range(keys[k]);
+	  ft::pair<ft_multimap::iterator, ft_multimap::iterator> ft_range = ft_map.equal_range(keys[k]);
+	  std::cout << keys[k] << ": STL count " << stl_map.count(keys[k]) << ", FT count " << ft_map.count(keys[k])
+				<< ", STL range " << std::distance(stl_range.first, stl_range.second)
+				<< ", FT range " << ft::distance(ft_range.first, ft_range.second) << std::endl;
+	}
+	std::cout << "STL Multimap find (42) = " << stl_map.find(42)->second << std::endl;
+	std::cout << "FT Multimap find (42) = " << ft_map.find(42)->second << std::endl;
+	std::cout << "\n";
+
+	testName = "ERASE KEY";
+
+	for (int key = 0; key < 101; key += 4) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	stl_map.erase(stl_map.find(41));
+	ft_map.erase(ft_map.find(41));
+	stl_map.erase(stl_map.lower_bound(50), stl_map.upper_bound(60));
+	ft_map.erase(ft_map.lower_bound(50), ft_map.upper_bound(60));
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "COPY CONSTRUCTOR";
+
+	stl_multimap stl_copy(stl_map);
+	ft_multimap ft_copy(ft_map);
+
+	printValues(stl_copy, ft_copy, testName);
+
+	testName = "OPERATOR=";
+
+	ft_multimap ft_assigned;
+	ft_assigned.insert(ft::make_pair(7, 7));
+	ft_assigned = ft_copy;
+	std::cout << "Result of operator== after operator=: " << is_equal(ft_assigned == ft_map, true) << std::endl;
+
+	printValues(stl_copy, ft_assigned, testName);
+  }
+  {
+	testName = "PLAIN TREE BACKEND";
+
+	typedef ft::rb_map_tree<int, int>::type plain_tree;
+	stl_multimap stl_map;
+	ft::multimap<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, plain_tree> ft_map;
+
+	for (int i = 0; i < 2000; i++) {
+	  stl_map.insert(std::make_pair(i % 37, i));
+	  ft_map.insert(ft::make_pair(i % 37, i));
+	}
+	stl_map.erase(5);
+	ft_map.erase(5);
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Multimap count (6) = " << stl_map.count(6) << std::endl;
+	std::cout << "FT Multimap count (6) = " << ft_map.count(6) << std::endl;
+	std::cout << "\n";
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "ERASE LONG RANGE INSIDE EQUAL KEYS";
+
+	//оба конца диапазона внутри серий равных ключей
+	typedef ft::rb_map_tree<int, int>::type plain_tree;
+	stl_multimap stl_map;
+	ft_multimap ft_map;
+	ft::multimap<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, plain_tree> ft_plain_map;
+
+	for (int key = 0; key < 50; key++) {
+	  for (int dup = 0; dup < 10; dup++) {
+		stl_map.insert(std::make_pair(key, dup));
+		ft_map.insert(ft::make_pair(key, dup));
+		ft_plain_map.insert(ft::make_pair(key, dup));
+	  }
+	}
+	stl_multimap::iterator stl_first = stl_map.begin();
+	ft_multimap::iterator ft_first = ft_map.begin();
+	ft::multimap<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, plain_tree>::iterator
+		ft_plain_first = ft_plain_map.begin();
+	for (int i = 0; i < 15; i++) {
+	  ++stl_first;
+	  ++ft_first;
+	  ++ft_plain_first;
+	}
+	stl_multimap::iterator stl_last = stl_first;
+	ft_multimap::iterator ft_last = ft_first;
+	ft::multimap<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, plain_tree>::iterator
+		ft_plain_last = ft_plain_first;
+	for (int i = 0; i < 300; i++) {
+	  ++stl_last;
+	  ++ft_last;
+	  ++ft_plain_last;
+	}
+	stl_map.erase(stl_first, stl_last);
+	ft_map.erase(ft_first, ft_last);
+	ft_plain_map.erase(ft_plain_first, ft_plain_last);
+
+	printValues(stl_map, ft_map, testName);
+	printValues(stl_map, ft_plain_map, testName + " (PLAIN TREE)");
+  }
+    {
+        testName = "SPEED TEST";
+        std::cout << "\n";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+        time_t start, end;
+        double time_taken_workaround, time_taken_ft, time_taken_stl;
+        const int count = 200000;
+        size_t counted_stl = 0, counted_ft = 0;
+
+        //вставка: map векторов против multimap
+        start = clock();
+        ft::map<int, ft::vector<int> > workaround;
+        for (int i = 0; i < count; i++)
+            workaround[i % 1000].push_back(i);
+        end = clock();
+        time_taken_workaround = end - start;
+        std::cout << "FT map of vectors insertion time is " << time_taken_workaround << " ms" << std::endl;
+
+        stl_multimap stl_map;
+        start = clock();
+        ft_multimap ft_map;
+        for (int i = 0; i < count; i++)
+            ft_map.insert(ft::make_pair(i % 1000, i));
+        end = clock();
+        time_taken_ft = end - start;
+        std::cout << "FT multimap insertion time is " << time_taken_ft << " ms" << std::endl;
+        for (int i = 0; i < count; i++)
+            stl_map.insert(std::make_pair(i % 1000, i));
+
+        //подсчёт ключей с 200 дубликатами
+        start = clock();
+        for (int round = 0; round < 20; round++)
+            for (int key = 0; key < 1000; key++)
+                counted_stl += stl_map.count(key);
+        end = clock();
+        time_taken_stl = end - start;
+        std::cout << "STL multimap count time is " << time_taken_stl << " ms" << std::endl;
+
+        start = clock();
+        for (int round = 0; round < 20; round++)
+            for (int key = 0; key < 1000; key++)
+                counted_ft += ft_map.count(key);
+        end = clock();
+        time_taken_ft = end - start;
+        std::cout << "FT multimap count time is " << time_taken_ft << " ms" << std::endl;
+        std::cout << "Result of count comparison: " << is_equal(counted_stl, counted_ft) << std::endl;
+        std::cout << "FT multimap count faster in " << time_taken_stl / time_taken_ft << " times";
+        std::cout << "\n\n";
+    }
+}
@@ -0,0 +1,160 @@
+#include "../src/multiset.hpp"
+#include <set>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+
+typedef std::multiset<std::string> stl_multiset;
+typedef ft::multiset<std::string> ft_multiset;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_multiset &stl_set, const ft_multiset &ft_set) {
+  ft_multiset::const_iterator ft_it;
+  stl_multiset::const_iterator stl_it;
+  if (ft_set.size() != stl_set.size())
+	return ("NOT EQUAL");
+  stl_it = stl_set.begin();
+  for (ft_it = ft_set.begin(); ft_it != ft_set.end(); ft_it++) {
+	if (*ft_it != *stl_it)
+	  return ("NOT EQUAL");
+	stl_it++;
+  }
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_multiset &stl_set, ft_multiset &ft_set, const std::string &testName) {
+  //stl multiset
+  std::string stl_empty = ((stl_set.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_set.size();
+
+  //ft multiset
+  std::string ft_empty = ((ft_set.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_set.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_set, ft_set);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Multiset";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Multiset";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+void
+test_multiset() {
+  std::cout << "**********MULTISET TEST**********\n";
+  std::string testName;
+  const std::string string_array[] = {"one", "two", "three", "four", "five"};
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_multiset stl_set;
+	ft_multiset ft_set;
+
+	printValues(stl_set, ft_set, testName);
+  }
+  {
+	testName = "RANGE CONSTRUCTOR";
+
+	std::string words[20];
+	for (int i = 0; i < 20; i++)
+	  words[i] = string_array[(i * 3) % 5];
+	stl_multiset stl_set(words, words + 20);
+	ft_multiset ft_set(words, words + 20);
+
+	printValues(stl_set, ft_set, testName);
+
+	testName = "COUNT / EQUAL RANGE";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Multiset count (two) = " << stl_set.count("two") << std::endl;
+	std::cout << "FT Multiset count (two) = " << ft_set.count("two") << std::endl;
+	std::cout << "STL Multiset equal range (six) = "
+			  << std::distance(stl_set.equal_range("six").first, stl_set.equal_range("six").second) << std::endl;
+	std::cout << "FT Multiset equal range (six) = "
+			  << ft::distance(ft_set.equal_range("six").first, ft_set.equal_range("six").second) << std::endl;
+	std::cout << "STL Multiset upper bound (four) = " << *stl_set.upper_bound("four") << std::endl;
+	std::cout << "FT Multiset upper bound (four) = " << *ft_set.upper_bound("four") << std::endl;
+	std::cout << "\n";
+
+	testName = "ERASE";
+
+	std::cout << "STL Multiset erase (three) = " << stl_set.erase("three") << std::endl;
+	std::cout << "FT Multiset erase (three) = " << ft_set.erase("three") << std::endl;
+	stl_set.erase(stl_set.find("one"));
+	ft_set.erase(ft_set.find("one"));
+
+	printValues(stl_set, ft_set, testName);
+
+	testName = "SWAP";
+
+	stl_multiset stl_other;
+	ft_multiset ft_other;
+	stl_other.insert("zero");
+	ft_other.insert("zero");
+	stl_set.swap(stl_other);
+	ft_set.swap(ft_other);
+
+	printValues(stl_set, ft_set, testName);
+	printValues(stl_other, ft_other, testName);
+  }
+  {
+	testName = "ERASE LONG RANGE INSIDE EQUAL KEYS";
+
+	//50 ключей по 10 копий, диапазон из 300 элементов начинается с 16-го
+	stl_multiset stl_set;
+	ft_multiset ft_set;
+	for (int key = 0; key < 50; key++) {
+	  std::string word(1, static_cast<char>('A' + key / 10));
+	  word += static_cast<char>('0' + key % 10);
+	  for (int dup = 0; dup < 10; dup++) {
+		stl_set.insert(word);
+		ft_set.insert(word);
+	  }
+	}
+	stl_multiset::iterator stl_first = stl_set.begin();
+	ft_multiset::iterator ft_first = ft_set.begin();
+	for (int i = 0; i < 15; i++) {
+	  ++stl_first;
+	  ++ft_first;
+	}
+	stl_multiset::iterator stl_last = stl_first;
+	ft_multiset::iterator ft_last = ft_first;
+	for (int i = 0; i < 300; i++) {
+	  ++stl_last;
+	  ++ft_last;
+	}
+	stl_set.erase(stl_first, stl_last);
+	ft_set.erase(ft_first, ft_last);
+
+	printValues(stl_set, ft_set, testName);
+  }
+}
@@ -0,0 +1,253 @@
+#include "../src/persistent_map.hpp"
+#include "../src/map.hpp"
+#include <map>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+#include <pthread.h>
+
+typedef std::map<int, int> stl_map_type;
+typedef ft::persistent_map<int, int> ft_persistent_map;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_map_type &stl_map, const ft_persistent_map &ft_map) {
+  ft_persistent_map::const_iterator ft_it = ft_map.begin();
+  for (stl_map_type::const_iterator stl_it = stl_map.begin(); stl_it != stl_map.end(); stl_it++, ft_it++) {
+	if (ft_it == ft_map.end() || ft_it->first != stl_it->first || ft_it->second != stl_it->second)
+	  return ("NOT EQUAL");
+  }
+  if (ft_it != ft_map.end())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_map_type &stl_map, ft_persistent_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft persistent map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Persistent Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+struct snapshot_reader_args {
+  const ft_persistent_map *map;
+  volatile int *done;
+  int snapshots;
+  int torn_snapshots;
+};
+
+// The writer keeps the keys a sliding window [lo, hi] with value == key;
+// every snapshot must show one whole window.
+static void *
+snapshot_reader_thread(void *arg) {
+  snapshot_reader_args *args = static_cast<snapshot_reader_args *>(arg);
+  while (!__atomic_load_n(args->done, __ATOMIC_ACQUIRE)) {
+	ft_persistent_map snapshot = args->map->snapshot();
+	args->snapshots++;
+	size_t walked = 0;
+	int expected = snapshot.empty() ? 0 : snapshot.begin()->first;
+	for (ft_persistent_map::const_iterator it = snapshot.begin(); it != snapshot.end(); ++it, ++walked, ++expected) {
+	  if (it->first != expected || it->second != it->first)
+		args->torn_snapshots++;
+	}
+	if (walked != snapshot.size())
+	  args->torn_snapshots++;
+  }
+  return 0;
+}
+
+void
+test_persistent_map() {
+  std::cout << "**********PERSISTENT MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_map_type stl_map;
+	ft_persistent_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE";
+
+	stl_map_type stl_map;
+	ft_persistent_map ft_map;
+
+	for (int i = 0; i < 1000; i++) {
+	  int key = (i * 7919) % 1009;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+	for (int key = 0; key < 1009; key += 5) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	for (int key = 1; key < 1009; key += 7) {
+	  stl_map[key] = -key;
+	  ft_map.insert_or_assign(key, -key);
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "FIND / LOWER BOUND / AT";
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Map find (8) = " << stl_map.find(8)->second << std::endl;
+	std::cout << "FT Persistent Map find (8) = " << ft_map.find(8)->second << std::endl;
+	std::cout << "STL Map lower bound (10) = " << stl_map.lower_bound(10)->first << std::endl;
+	std::cout << "FT Persistent Map lower bound (10) = " << ft_map.lower_bound(10)->first << std::endl;
+	std::cout << "STL Map at (22) = " << stl_map.at(22) << std::endl;
+	std::cout << "FT Persistent Map at (22) = " << ft_map.at(22) << std::endl;
+	std::cout << "\n";
+
+	testName = "SNAPSHOT";
+
+	stl_map_type stl_before(stl_map);
+	ft_persistent_map ft_before = ft_map.snapshot();
+	for (int key = 0; key < 1009; key += 3) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	stl_map[5000] = 5000;
+	ft_map.insert_or_assign(5000, 5000);
+	stl_map[8] = 0;
+	ft_map.insert_or_assign(8, 0);
+
+	printValues(stl_map, ft_map, testName + " (CURRENT)");
+	printValues(stl_before, ft_before, testName + " (BEFORE)");
+
+	testName = "OPERATOR= / CLEAR";
+
+	ft_before = ft_map;
+	ft_map.clear();
+	std::cout << "Result of operator== after operator=: " << is_equal(ft_before == ft_map, false) << std::endl;
+	printValues(stl_map, ft_before, testName + " (ASSIGNED)");
+	stl_map.clear();
+	printValues(stl_map, ft_map, testName + " (CLEARED)");
+  }
+  {
+	testName = "SNAPSHOTS WHILE WRITING";
+
+	const int readers = 4;
+	ft_persistent_map ft_map;
+	volatile int done = 0;
+	snapshot_reader_args args[readers];
+	pthread_t threads[readers];
+
+	for (int t = 0; t < readers; t++) {
+	  args[t].map = &ft_map;
+	  args[t].done = &done;
+	  args[t].snapshots = 0;
+	  args[t].torn_snapshots = 0;
+	  pthread_create(&threads[t], 0, snapshot_reader_thread, &args[t]);
+	}
+	//окно из 100 ключей сдвигается вправо
+	for (int key = 0; key < 20000; key++) {
+	  ft_map.insert(ft::make_pair(key, key));
+	  if (key >= 100)
+		ft_map.erase(key - 100);
+	}
+	__atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+	int torn_snapshots = 0;
+	for (int t = 0; t < readers; t++) {
+	  pthread_join(threads[t], 0);
+	  torn_snapshots += args[t].torn_snapshots;
+	}
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Torn snapshots: " << torn_snapshots << std::endl;
+	std::cout << "Final size = " << ft_map.size() << ", first key = " << ft_map.begin()->first << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	time_t start, end;
+	double time_taken_copy, time_taken_snapshot, time_taken_ft, time_taken_persistent;
+	const int count = 200000;
+	size_t copied_size = 0, snapshot_size = 0;
+
+	//вставка
+	ft::map<int, int> ft_map;
+	start = clock();
+	for (int i = 0; i < count; i++)
+	  ft_map.insert(ft::make_pair((int)(((long)i * 48271) % 1000003), i));
+	end = clock();
+	time_taken_ft = end - start;
+	std::cout << "FT map insertion time is " << time_taken_ft << " ms" << std::endl;
+
+	ft_persistent_map persistent;
+	start = clock();
+	for (int i = 0; i < count; i++)
+	  persistent.insert(ft::make_pair((int)(((long)i * 48271) % 1000003), i));
+	end = clock();
+	time_taken_persistent = end - start;
+	std::cout << "FT persistent map insertion time is " << time_taken_persistent << " ms" << std::endl;
+
+	//точка во времени: копия карты против снимка, 100 раз по 1000 записей
+	start = clock();
+	for (int round = 0; round < 100; round++) {
+	  ft::map<int, int> copy(ft_map);
+	  copied_size += copy.size();
+	  for (int i = 0; i < 1000; i++)
+		ft_map.insert_or_assign(round * 1000 + i, i);
+	}
+	end = clock();
+	time_taken_copy = end - start;
+	std::cout << "FT map copy + writes time is " << time_taken_copy << " ms" << std::endl;
+
+	start = clock();
+	for (int round = 0; round < 100; round++) {
+	  ft_persistent_map snapshot = persistent.snapshot();
+	  snapshot_size += snapshot.size();
+	  for (int i = 0; i < 1000; i++)
+		persistent.insert_or_assign(round * 1000 + i, i);
+	}
+	end = clock();
+	time_taken_snapshot = end - start;
+	std::cout << "FT persistent map snapshot + writes time is " << time_taken_snapshot << " ms" << std::endl;
+	std::cout << "Result of size comparison: " << is_equal(copied_size, snapshot_size) << std::endl;
+	std::cout << "FT persistent map faster in " << time_taken_copy / time_taken_snapshot << " times";
+	std::cout << "\n\n";
+  }
+}
@@ -0,0 +1,387 @@
+#include "../src/rcu_map.hpp"
+#include "../src/concurrent_map.hpp"
+#include "../src/map.hpp"
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef std::map<int, int> stl_map_type;
+typedef ft::rcu_map<int, int> ft_rcu_map;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_map_type &stl_map, const ft_rcu_map &ft_map) {
+  const ft_rcu_map::version_type &version = ft_map.read();
+  ft_rcu_map::const_iterator ft_it = version.begin();
+  for (stl_map_type::const_iterator stl_it = stl_map.begin(); stl_it != stl_map.end(); stl_it++, ft_it++) {
+	if (ft_it == version.end() || ft_it->first != stl_it->first || ft_it->second != stl_it->second)
+	  return ("NOT EQUAL");
+  }
+  if (ft_it != version.end())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_map_type &stl_map, ft_rcu_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft rcu map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT RCU Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+// Nanoseconds of wall time: a lookup that waits on a lock is not on CPU.
+static double
+rcu_wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct rcu_window_args {
+  ft_rcu_map *map;
+  volatile int *done;
+  int reads;
+  int torn_reads;
+};
+
+// The writer keeps the keys a sliding window [lo, hi] with value == key;
+// every version a reader walks must show one whole window.
+static void *
+rcu_window_reader(void *arg) {
+  rcu_window_args *args = static_cast<rcu_window_args *>(arg);
+  args->map->register_reader();
+  while (!__atomic_load_n(args->done, __ATOMIC_ACQUIRE)) {
+	const ft_rcu_map::version_type &version = args->map->read();
+	args->reads++;
+	size_t walked = 0;
+	int expected = version.empty() ? 0 : version.begin()->first;
+	for (ft_rcu_map::const_iterator it = version.begin(); it != version.end(); ++it, ++walked, ++expected) {
+	  if (it->first != expected || it->second != it->first)
+		args->torn_reads++;
+	}
+	if (walked != version.size())
+	  args->torn_reads++;
+	args->map->quiescent_state();
+  }
+  args->map->unregister_reader();
+  return 0;
+}
+
+// ft::map behind one mutex, and ft::map behind a reader-writer lock.
+struct rcu_mutex_map {
+  ft::map<int, int> map;
+  ft::mutex lock;
+
+  bool find(int key, int &value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	ft::map<int, int>::iterator it = map.find(key);
+	if (it == map.end())
+	  return false;
+	value = it->second;
+	return true;
+  }
+
+  void insert_or_assign(int key, int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.insert_or_assign(key, value);
+  }
+};
+
+struct rcu_rw_lock_map {
+  ft::map<int, int> map;
+  ft::rw_lock lock;
+
+  bool find(int key, int &value) {
+	ft::shared_lock_guard<ft::rw_lock> guard(lock);
+	ft::map<int, int>::const_iterator it = map.find(key);
+	if (it == map.end())
+	  return false;
+	value = it->second;
+	return true;
+  }
+
+  void insert_or_assign(int key, int value) {
+	ft::lock_guard<ft::rw_lock> guard(lock);
+	map.insert_or_assign(key, value);
+  }
+};
+
+// Only the rcu map needs its readers to check in and out.
+template<class Map>
+static void rcu_enter(Map &) {}
+template<class Map>
+static void rcu_leave(Map &) {}
+template<class Map>
+static void rcu_between_requests(Map &) {}
+
+static void rcu_enter(ft_rcu_map &map) { map.register_reader(); }
+static void rcu_leave(ft_rcu_map &map) { map.unregister_reader(); }
+static void rcu_between_requests(ft_rcu_map &map) { map.quiescent_state(); }
+
+static const int rcu_batch = 64;
+static const int rcu_batches = 2000;
+
+template<class Map>
+struct rcu_latency_args {
+  Map *map;
+  int thread;
+  volatile int *done;
+  long found;
+  long writes;
+  std::vector<double> batch_ns;
+};
+
+// A request is a batch of lookups; the time of each is one sample.
+template<class Map>
+static void *
+rcu_latency_reader(void *arg) {
+  rcu_latency_args<Map> *args = static_cast<rcu_latency_args<Map> *>(arg);
+  unsigned int seed = 12345u + args->thread * 7919u;
+  int value;
+  rcu_enter(*args->map);
+  for (int b = 0; b < rcu_batches; b++) {
+	double start = rcu_wall_ns();
+	for (int i = 0; i < rcu_batch; i++) {
+	  seed = seed * 1103515245u + 12345u;
+	  args->found += args->map->find((seed >> 8) % 65536, value);
+	}
+	args->batch_ns.push_back((rcu_wall_ns() - start) / rcu_batch);
+	rcu_between_requests(*args->map);
+  }
+  rcu_leave(*args->map);
+  return 0;
+}
+
+// A configuration change every 50 microseconds.
+template<class Map>
+static void *
+rcu_latency_writer(void *arg) {
+  rcu_latency_args<Map> *args = static_cast<rcu_latency_args<Map> *>(arg);
+  unsigned int seed = 54321u + args->thread * 7919u;
+  while (!__atomic_load_n(args->done, __ATOMIC_ACQUIRE)) {
+	seed = seed * 1103515245u + 12345u;
+	args->map->insert_or_assign((seed >> 8) % 65536, args->thread);
+	args->writes++;
+	usleep(50);
+  }
+  return 0;
+}
+
+// Median and 99th percentile of the per-lookup time, in nanoseconds.
+template<class Map>
+static void
+rcu_latency_bench(Map &map, int readers, int writers, double &median, double &p99, long &writes) {
+  std::vector<rcu_latency_args<Map> > args(readers + writers);
+  std::vector<pthread_t> threads(readers + writers);
+  volatile int done = 0;
+  for (int i = 0; i < 65536; i += 2)
+	map.insert_or_assign(i, i);
+  for (int t = 0; t < readers + writers; t++) {
+	args[t].map = &map;
+	args[t].thread = t;
+	args[t].done = &done;
+	args[t].found = 0;
+	args[t].writes = 0;
+  }
+  for (int t = 0; t < writers; t++)
+	pthread_create(&threads[readers + t], 0, rcu_latency_writer<Map>, &args[readers + t]);
+  for (int t = 0; t < readers; t++)
+	pthread_create(&threads[t], 0, rcu_latency_reader<Map>, &args[t]);
+  for (int t = 0; t < readers; t++)
+	pthread_join(threads[t], 0);
+  __atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+  for (int t = 0; t < writers; t++)
+	pthread_join(threads[readers + t], 0);
+
+  std::vector<double> samples;
+  writes = 0;
+  for (int t = 0; t < readers; t++)
+	samples.insert(samples.end(), args[t].batch_ns.begin(), args[t].batch_ns.end());
+  for (int t = 0; t < writers; t++)
+	writes += args[readers + t].writes;
+  std::sort(samples.begin(), samples.end());
+  median = samples[samples.size() / 2];
+  p99 = samples[samples.size() * 99 / 100];
+}
+
+template<class Map>
+static void
+rcu_print_latency(const std::string &name, int readers, int writers) {
+  Map map;
+  double median, p99;
+  long writes;
+  rcu_latency_bench(map, readers, writers, median, p99, writes);
+  std::cout << name << ", " << writers << " writers: lookup time is " << std::fixed << std::setprecision(0)
+			<< median << " ns median, " << p99 << " ns p99 (" << writes << " writes)" << std::endl;
+  std::cout.unsetf(std::ios::fixed);
+  std::cout << std::setprecision(6);
+}
+
+void
+test_rcu_map() {
+  std::cout << "**********RCU MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_map_type stl_map;
+	ft_rcu_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE";
+
+	stl_map_type stl_map;
+	ft_rcu_map ft_map;
+
+	for (int i = 0; i < 1000; i++) {
+	  int key = (i * 7919) % 1009;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+	for (int key = 0; key < 1009; key += 5) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	for (int key = 1; key < 1009; key += 7) {
+	  stl_map[key] = -key;
+	  ft_map.insert_or_assign(key, -key);
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "FIND / COUNT";
+
+	int stl_value = stl_map.find(8)->second;
+	int ft_value = 0;
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Map find (8) = " << stl_value << std::endl;
+	std::cout << "FT RCU Map find (8) = " << ft_map.find(8, ft_value) << " " << ft_value << std::endl;
+	std::cout << "STL Map count (10) = " << stl_map.count(10) << std::endl;
+	std::cout << "FT RCU Map count (10) = " << ft_map.count(10) << std::endl;
+	std::cout << "\n";
+
+	testName = "CLEAR";
+
+	stl_map.clear();
+	ft_map.clear();
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "GRACE PERIODS";
+
+	ft_rcu_map ft_map;
+
+	//читатель, который не сообщает о покое, держит все старые версии
+	ft_map.register_reader();
+	for (int key = 0; key < 100; key++)
+	  ft_map.insert(ft::make_pair(key, key));
+	size_t held = ft_map.retired();
+	ft_map.quiescent_state();
+	ft_map.insert(ft::make_pair(100, 100));
+	size_t after_quiescent = ft_map.retired();
+	ft_map.unregister_reader();
+	ft_map.synchronize();
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Retired versions while the reader holds = " << held << std::endl;
+	std::cout << "Retired versions after a quiescent state = " << after_quiescent << std::endl;
+	std::cout << "Retired versions after synchronize = " << ft_map.retired() << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "READERS WHILE WRITING";
+
+	const int readers = 4;
+	ft_rcu_map ft_map;
+	volatile int done = 0;
+	rcu_window_args args[readers];
+	pthread_t threads[readers];
+
+	for (int t = 0; t < readers; t++) {
+	  args[t].map = &ft_map;
+	  args[t].done = &done;
+	  args[t].reads = 0;
+	  args[t].torn_reads = 0;
+	  pthread_create(&threads[t], 0, rcu_window_reader, &args[t]);
+	}
+	//окно из 100 ключей сдвигается вправо
+	for (int key = 0; key < 20000; key++) {
+	  ft_map.insert(ft::make_pair(key, key));
+	  if (key >= 100)
+		ft_map.erase(key - 100);
+	}
+	__atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+	int torn_reads = 0;
+	for (int t = 0; t < readers; t++) {
+	  pthread_join(threads[t], 0);
+	  torn_reads += args[t].torn_reads;
+	}
+	ft_map.synchronize();
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Torn reads: " << torn_reads << std::endl;
+	std::cout << "Final size = " << ft_map.size() << ", first key = " << ft_map.read().begin()->first << std::endl;
+	std::cout << "Retired versions after synchronize = " << ft_map.retired() << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int readers = 4;
+
+	//задержка чтения: 4 читателя, 0, 1 и 2 писателя
+	for (int writers = 0; writers <= 2; writers++) {
+	  rcu_print_latency<rcu_mutex_map>("FT map + mutex", readers, writers);
+	  rcu_print_latency<rcu_rw_lock_map>("FT map + rw_lock", readers, writers);
+	  rcu_print_latency<ft::concurrent_map<int, int> >("FT concurrent map", readers, writers);
+	  rcu_print_latency<ft_rcu_map>("FT rcu map", readers, writers);
+	}
+	std::cout << "\n";
+  }
+}
@@ -2,23 +2,35 @@
 #include <set>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
 
 #define GREEN "\33[1;32m"
 #define RED "\33[1;31m"
 #define REST "\33[1;0m"
 
 
+struct no_default {
+    int value;
+
+    explicit no_default(int value) : value(value) {}
+
+    bool operator<(const no_default& other) const { return value < other.value; }
+    bool operator==(const no_default& other) const { return value == other.value; }
+};
+
 template<class T>
 std::string
 is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
 
-template<class T>
+template<class T, class Comp, class Alloc, class Tree>
 std::string
 is_equal_content(
         std::set<T> &stl_set,
-        ft::set<T> &ft_set
+        ft::set<T, Comp, Alloc, Tree> &ft_set
 ) {
-    typename ft::set<T>::iterator ft_it;
+    typename ft::set<T, Comp, Alloc, Tree>::iterator ft_it;
     typename std::set<T>::iterator stl_it;
 
     if (ft_set.size() != stl_set.size())
@@ -34,11 +46,11 @@ is_equal_content(
     return ("EQUAL");
 }
 
-template<class T>
+template<class T, class Comp, class Alloc, class Tree>
 void
 printValues(
         std::set<T> &stl_set,
-        ft::set<T> &ft_set, std::string testName
+        ft::set<T, Comp, Alloc, Tree> &ft_set, std::string testName
 ) {
     //real set
     std::string stl_empty = ((stl_set.empty() == 1) ? "true" : "false");
@@ -80,14 +92,14 @@ printValues(
     std::cout << "**********************************************************************" << std::endl;
 }
 
-template<class T>
+template<class T, class Comp, class Alloc, class Tree>
 void
 printSets(
         std::set<T> &stl_set,
-        ft::set<T> &ft_set
+        ft::set<T, Comp, Alloc, Tree> &ft_set
 ) {
     typename std::set<T>::iterator stl_it;
-    typename ft::set<T>::iterator ft_it;
+    typename ft::set<T, Comp, Alloc, Tree>::iterator ft_it;
     stl_it = stl_set.begin();
     ft_it = ft_set.begin();
 
@@ -114,14 +126,14 @@ printSets(
     std::cout << "\n\n";
 }
 
-template<class T>
+template<class T, class Comp, class Alloc, class Tree>
 void
 printSets2(
         std::set<T> &stl_set,
-ft::set<T> &ft_set
+ft::set<T, Comp, Alloc, Tree> &ft_set
 ) {
 typename std::set<T>::iterator stl_it;
-typename ft::set<T>::iterator ft_it;
+typename ft::set<T, Comp, Alloc, Tree>::iterator ft_it;
 stl_it = stl_set.begin();
 ft_it = ft_set.begin();
 
@@ -455,6 +467,303 @@ test_set() {
         printSets(stl_set, ft_set);
 
     }
+    {
+        testName = "BPLUS TREE BACKEND";
+
+        std::set<int> stl_set;
+        ft::set<int, ft::less<int>, std::allocator<int>,
+            ft::bplus_set_tree<int, ft::less<int>, std::allocator<int>, 64>::type> ft_set;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            stl_set.insert((i * 389) % 1009);
+            ft_set.insert((i * 389) % 1009);
+        }
+        for (int i = 0; i < 1009; i += 2)
+        {
+            stl_set.erase(i);
+            ft_set.erase(i);
+        }
+        printValues(stl_set, ft_set, testName);
+        std::cout << "STL Set lower bound (500) = " << *stl_set.lower_bound(500) << std::endl;
+        std::cout << "FT Set lower bound (500) = " << *ft_set.lower_bound(500) << std::endl;
+        std::cout << "\n";
+    }
+    {
+        testName = "ARENA TREE BACKEND";
+
+        std::set<int> stl_set;
+        ft::set<int, ft::less<int>, std::allocator<int>, ft::rb_arena_set_tree<int>::type> ft_set;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            stl_set.insert((i * 389) % 1009);
+            ft_set.insert((i * 389) % 1009);
+        }
+        for (int i = 0; i < 1009; i += 2)
+        {
+            stl_set.erase(i);
+            ft_set.erase(i);
+        }
+        printValues(stl_set, ft_set, testName);
+        std::cout << "STL Set upper bound (500) = " << *stl_set.upper_bound(500) << std::endl;
+        std::cout << "FT Set upper bound (500) = " << *ft_set.upper_bound(500) << std::endl;
+        std::cout << "\n";
+    }
+    {
+        testName = "ORDER STATISTICS";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+
+        std::set<int> stl_set;
+        ft::set<int, ft::less<int>, std::allocator<int>, ft::rb_ranked_set_tree<int>::type> ft_set;
+        for (int i = 0; i < 1000; i++)
+        {
+            stl_set.insert((i * 389) % 1009);
+            ft_set.insert((i * 389) % 1009);
+        }
+        for (int i = 0; i < 1009; i += 4)
+        {
+            stl_set.erase(i);
+            ft_set.erase(i);
+        }
+        std::set<int>::iterator stl_median = stl_set.begin();
+        std::advance(stl_median, stl_set.size() / 2);
+        std::cout << "STL Set median = " << *stl_median << std::endl;
+        std::cout << "FT Set median = " << *ft_set.nth(ft_set.size() / 2) << std::endl;
+        std::cout << "STL Set rank (500) = " << std::distance(stl_set.begin(), stl_set.lower_bound(500)) << std::endl;
+        std::cout << "FT Set rank (500) = " << ft_set.rank(500) << std::endl;
+        std::cout << "STL Set distance (100, 900) = "
+                  << std::distance(stl_set.find(101), stl_set.find(901)) << std::endl;
+        std::cout << "FT Set distance (100, 900) = "
+                  << ft::distance(ft_set.find(101), ft_set.find(901)) << std::endl;
+        if (ft_set.nth(ft_set.size()) == ft_set.end())
+            std::cout << GREEN " OK " REST << std::endl;
+        else
+            std::cout << RED " NOT OK " REST << std::endl;
+        printValues(stl_set, ft_set, testName);
+
+        time_t start, end;
+        double time_taken_stl, time_taken_ft;
+        long checksum = 0;
+        start = clock();
+        for (std::size_t p = 1; p < 100; p++)
+        {
+            std::set<int>::iterator it = stl_set.begin();
+            std::advance(it, stl_set.size() * p / 100);
+            checksum += *it;
+        }
+        end = clock();
+        time_taken_stl = end - start;
+        start = clock();
+        for (std::size_t p = 1; p < 100; p++)
+            checksum -= *ft_set.nth(ft_set.size() * p / 100);
+        end = clock();
+        time_taken_ft = end - start;
+        std::cout << "STL percentiles by advance time is " << time_taken_stl << " ms" << std::endl;
+        std::cout << "FT percentiles by nth time is " << time_taken_ft << " ms" << std::endl;
+        std::cout << "Percentile checksum = " << checksum << std::endl;
+        std::cout << "\n";
+    }
+    {
+        testName = "SPLIT / JOIN";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+
+        std::set<int> stl_set;
+        std::set<int> stl_upper;
+        ft::set<int> ft_set;
+        ft::set<int> ft_upper;
+        for (int i = 0; i < 1000; i++)
+        {
+            stl_set.insert((i * 389) % 1009);
+            ft_set.insert((i * 389) % 1009);
+        }
+        ft_upper.insert(-1);
+        stl_upper.insert(stl_set.lower_bound(600), stl_set.end());
+        stl_set.erase(stl_set.lower_bound(600), stl_set.end());
+        ft_set.split(600, ft_upper);
+        printValues(stl_set, ft_set, testName + " (LOWER)");
+        printValues(stl_upper, ft_upper, testName + " (UPPER)");
+
+        stl_upper.insert(stl_set.begin(), stl_set.end());
+        stl_set.clear();
+        ft_upper.join(ft_set);
+        printValues(stl_upper, ft_upper, testName + " (JOINED)");
+        printValues(stl_set, ft_set, testName + " (EMPTIED)");
+    }
+    {
+        testName = "SET OPERATIONS";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+
+        const char* names[] = {"UNION", "INTERSECTION", "DIFFERENCE"};
+        // Similar sizes take the linear merge, different sizes split and join.
+        const int sizes[][2] = {{3000, 2000}, {3000, 40}};
+        for (int s = 0; s < 2; s++)
+        {
+            for (int operation = 0; operation < 3; operation++)
+            {
+                std::set<int> stl_lhs, stl_rhs, stl_result;
+                ft::set<int> ft_lhs, ft_rhs;
+                for (int i = 0; i < sizes[s][0]; i++)
+                {
+                    stl_lhs.insert((i * 389) % 5003);
+                    ft_lhs.insert((i * 389) % 5003);
+                }
+                for (int i = 0; i < sizes[s][1]; i++)
+                {
+                    stl_rhs.insert((i * 577) % 5003);
+                    ft_rhs.insert((i * 577) % 5003);
+                }
+                if (operation == 0)
+                {
+                    std::set_union(stl_lhs.begin(), stl_lhs.end(), stl_rhs.begin(), stl_rhs.end(),
+                                   std::inserter(stl_result, stl_result.end()));
+                    ft_lhs.unite(ft_rhs);
+                }
+                else if (operation == 1)
+                {
+                    std::set_intersection(stl_lhs.begin(), stl_lhs.end(), stl_rhs.begin(), stl_rhs.end(),
+                                          std::inserter(stl_result, stl_result.end()));
+                    ft_lhs.intersect(ft_rhs);
+                }
+                else
+                {
+                    std::set_difference(stl_lhs.begin(), stl_lhs.end(), stl_rhs.begin(), stl_rhs.end(),
+                                        std::inserter(stl_result, stl_result.end()));
+                    ft_lhs.subtract(ft_rhs);
+                }
+                std::ostringstream name;
+                name << testName << " " << names[operation] << " " << sizes[s][0] << " x " << sizes[s][1];
+                printValues(stl_result, ft_lhs, name.str());
+                if (ft_rhs.empty())
+                    std::cout << GREEN " OK " REST << std::endl;
+                else
+                    std::cout << RED " NOT OK " REST << std::endl;
+            }
+        }
+    }
+    {
+        testName = "NO DEFAULT CONSTRUCTOR";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+
+        ft::set<no_default> ft_set;
+        for (int i = 0; i < 10; i++)
+            ft_set.insert(no_default(i * 3 % 10));
+        ft_set.erase(no_default(5));
+
+        std::cout << "FT Set content: ";
+        for (ft::set<no_default>::iterator it = ft_set.begin(); it != ft_set.end(); ++it)
+            std::cout << it->value << " ";
+        std::cout << "\n";
+        if (ft_set.size() == 9 && ft_set.begin()->value == 0)
+            std::cout << GREEN " OK " REST << std::endl;
+        else
+            std::cout << RED " NOT OK " REST << std::endl;
+        std::cout << "\n";
+    }
+    {
+        testName = "NODE SIZE";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+
+        // Layout before the color was packed into the parent pointer.
+        struct legacy_node {
+            int         data;
+            void*       parent;
+            void*       left;
+            void*       right;
+            ft::color   color;
+        };
+        std::size_t legacy_size = sizeof(legacy_node);
+        std::size_t node_size = sizeof(ft::set<int>::tree_type::node_type);
+
+        std::cout << "Legacy set<int> node = " << legacy_size << " bytes" << std::endl;
+        std::cout << "FT set<int> node = " << node_size << " bytes" << std::endl;
+        if (node_size < legacy_size) {
+            std::cout << GREEN " OK " REST << std::endl;
+        } else {
+            std::cout << RED " NOT OK " REST << std::endl;
+        }
+
+        std::set<int> stl_set;
+        ft::set<int> ft_set;
+        for (int i = 0; i < 4000; i++)
+        {
+            stl_set.insert(i);
+            ft_set.insert(i);
+        }
+        for (int i = 0; i < 4000; i += 3)
+        {
+            stl_set.erase(i);
+            ft_set.erase(i);
+        }
+        printValues(stl_set, ft_set, testName);
+        std::cout << "\n";
+    }
+    {
+        testName = "SET OPERATIONS SPEED TEST";
+        std::cout << "\n";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+        time_t start, end;
+        double time_taken_element, time_taken_tree;
+        const char* names[] = {"union", "intersection", "difference"};
+
+        for (int operation = 0; operation < 3; operation++)
+        {
+            ft::set<int> lhs, rhs, element_lhs, element_rhs;
+            for (int i = 0; i < 1000000; i++)
+            {
+                lhs.insert(i * 2);
+                element_lhs.insert(i * 2);
+            }
+            for (int i = 0; i < 1000000; i += 10)
+            {
+                rhs.insert(i * 3);
+                element_rhs.insert(i * 3);
+            }
+
+            //поэлементно
+            start = clock();
+            if (operation == 0)
+            {
+                for (ft::set<int>::iterator it = element_rhs.begin(); it != element_rhs.end(); ++it)
+                    element_lhs.insert(*it);
+            }
+            else if (operation == 1)
+            {
+                ft::set<int> result;
+                for (ft::set<int>::iterator it = element_rhs.begin(); it != element_rhs.end(); ++it)
+                    if (element_lhs.find(*it) != element_lhs.end())
+                        result.insert(*it);
+                element_lhs.clear();
+                element_lhs.insert(result.begin(), result.end());
+            }
+            else
+            {
+                for (ft::set<int>::iterator it = element_rhs.begin(); it != element_rhs.end(); ++it)
+                    element_lhs.erase(*it);
+            }
+            element_rhs.clear();
+            end = clock();
+            time_taken_element = end - start;
+            std::cout << "Element-wise " << names[operation] << " 1M x 100K time is " << time_taken_element << " ms" << std::endl;
+
+            start = clock();
+            if (operation == 0)
+                lhs.unite(rhs);
+            else if (operation == 1)
+                lhs.intersect(rhs);
+            else
+                lhs.subtract(rhs);
+            end = clock();
+            time_taken_tree = end - start;
+            std::cout << "Tree " << names[operation] << " 1M x 100K time is " << time_taken_tree << " ms" << std::endl;
+            std::cout << "Result of size comparison: " << (lhs.size() == element_lhs.size() ? "ok" : "not ok") << std::endl;
+            if (time_taken_tree / time_taken_element > 1)
+                std::cout << "Tree " << names[operation] << " slower in " << time_taken_tree / time_taken_element << " times";
+            else
+                std::cout << "Tree " << names[operation] << " faster in " << time_taken_element / time_taken_tree << " times";
+            std::cout << "\n\n";
+        }
+    }
     {
         testName = "SPEED TEST";
         std::cout << "\n";
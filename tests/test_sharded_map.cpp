@@ -0,0 +1,299 @@
+#include "../src/sharded_map.hpp"
+#include "../src/concurrent_map.hpp"
+#include <map>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include "test_threads.hpp"
+
+typedef std::map<int, int> stl_map_type;
+typedef ft::sharded_map<int, int> ft_sharded_map;
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+static std::string
+is_equal_content(const stl_map_type &stl_map, const ft_sharded_map &ft_map) {
+  ft_sharded_map::ordered_view view(ft_map);
+  ft_sharded_map::ordered_view::const_iterator ft_it = view.begin();
+  for (stl_map_type::const_iterator stl_it = stl_map.begin(); stl_it != stl_map.end(); stl_it++, ft_it++) {
+	if (ft_it == view.end() || ft_it->first != stl_it->first || ft_it->second != stl_it->second)
+	  return ("NOT EQUAL");
+  }
+  if (ft_it != view.end())
+	return ("NOT EQUAL");
+  return ("EQUAL");
+}
+
+static void
+printValues(stl_map_type &stl_map, ft_sharded_map &ft_map, const std::string &testName) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft sharded map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Sharded Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+struct shard_writer_args {
+  ft_sharded_map *map;
+  int thread;
+  int threads;
+  int lost_writes;
+};
+
+// Each thread owns the keys equal to its number modulo the thread count.
+static void *
+shard_writer_thread(void *arg) {
+  shard_writer_args *args = static_cast<shard_writer_args *>(arg);
+  for (int i = 0; i < 2000; i++) {
+	int key = i * args->threads + args->thread;
+	args->map->insert(ft::make_pair(key, i));
+	int value = -1;
+	if (!args->map->find(key, value) || value != i)
+	  args->lost_writes++;
+  }
+  for (int i = 0; i < 2000; i += 3)
+	args->map->erase(i * args->threads + args->thread);
+  for (int i = 1; i < 2000; i += 3)
+	args->map->insert_or_assign(i * args->threads + args->thread, -i);
+  return 0;
+}
+
+// ft::map behind one mutex: the baseline the sharded map has to beat.
+struct global_lock_map {
+  ft::map<int, int> map;
+  ft::mutex lock;
+
+  bool find(int key, int &value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	ft::map<int, int>::iterator it = map.find(key);
+	if (it == map.end())
+	  return false;
+	value = it->second;
+	return true;
+  }
+
+  void insert_or_assign(int key, int value) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.insert_or_assign(key, value);
+  }
+
+  void erase(int key) {
+	ft::lock_guard<ft::mutex> guard(lock);
+	map.erase(key);
+  }
+};
+
+template<class Map>
+struct scaling_args {
+  Map *map;
+  int thread;
+  int ops;
+  long found;
+};
+
+// 20% reads, 80% writes spread over a 64K key space.
+template<class Map>
+static void *
+scaling_thread(void *arg) {
+  scaling_args<Map> *args = static_cast<scaling_args<Map> *>(arg);
+  unsigned int seed = 12345u + args->thread * 7919u;
+  int value;
+  for (int i = 0; i < args->ops; i++) {
+	seed = seed * 1103515245u + 12345u;
+	int key = (seed >> 8) % 65536;
+	int dice = (seed >> 4) % 10;
+	if (dice < 2)
+	  args->found += args->map->find(key, value);
+	else if (dice % 2)
+	  args->map->insert_or_assign(key, i);
+	else
+	  args->map->erase(key);
+  }
+  return 0;
+}
+
+template<class Map>
+static double
+run_scaling(int threads, int total_ops) {
+  Map *map = new Map;
+  std::vector<scaling_args<Map> > args(threads);
+  for (int i = 0; i < 65536; i += 2)
+	map->insert_or_assign(i, i);
+  for (int t = 0; t < threads; t++) {
+	args[t].map = map;
+	args[t].thread = t;
+	args[t].ops = total_ops / threads;
+	args[t].found = 0;
+  }
+  double start = wall_ms();
+  run_threads(scaling_thread<Map>, &args[0], sizeof(args[0]), threads);
+  double end = wall_ms();
+  delete map;
+  return end - start;
+}
+
+void
+test_sharded_map() {
+  std::cout << "**********SHARDED MAP TEST**********\n";
+  std::string testName;
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	stl_map_type stl_map;
+	ft_sharded_map ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "INSERT / ERASE";
+
+	stl_map_type stl_map;
+	ft_sharded_map ft_map;
+
+	for (int i = 0; i < 1000; i++) {
+	  int key = (i * 7919) % 1009;
+	  stl_map.insert(std::make_pair(key, i));
+	  ft_map.insert(ft::make_pair(key, i));
+	}
+	for (int key = 0; key < 1009; key += 5) {
+	  stl_map.erase(key);
+	  ft_map.erase(key);
+	}
+	for (int key = 1; key < 1009; key += 7) {
+	  stl_map[key] = -key;
+	  ft_map.insert_or_assign(key, -key);
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "FIND / COUNT";
+
+	int ft_value = 0;
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "STL Map find (8) = " << stl_map.find(8)->second << std::endl;
+	std::cout << "FT Sharded Map find (8) = " << ft_map.find(8, ft_value) << " " << ft_value << std::endl;
+	std::cout << "STL Map count (10) = " << stl_map.count(10) << std::endl;
+	std::cout << "FT Sharded Map count (10) = " << ft_map.count(10) << std::endl;
+	std::cout << "\n";
+
+	testName = "CLEAR";
+
+	stl_map.clear();
+	ft_map.clear();
+
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "ONE SHARD / MANY SHARDS";
+
+	ft::sharded_map<int, int, 1> one_shard;
+	ft::sharded_map<int, int, 61> many_shards;
+	for (int i = 0; i < 500; i++) {
+	  one_shard.insert(ft::make_pair((i * 31) % 509, i));
+	  many_shards.insert(ft::make_pair((i * 31) % 509, i));
+	}
+	ft::sharded_map<int, int, 1>::ordered_view one_view(one_shard);
+	ft::sharded_map<int, int, 61>::ordered_view many_view(many_shards);
+	ft::sharded_map<int, int, 1>::ordered_view::const_iterator one_it = one_view.begin();
+	ft::sharded_map<int, int, 61>::ordered_view::const_iterator many_it = many_view.begin();
+	int mismatches = 0;
+	for (; one_it != one_view.end() && many_it != many_view.end(); ++one_it, ++many_it)
+	  mismatches += one_it->first != many_it->first || one_it->second != many_it->second;
+	mismatches += (one_it != one_view.end()) + (many_it != many_view.end());
+
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	std::cout << "Ordered view mismatches: " << mismatches << std::endl;
+
+	//поиск через view, не через саму карту
+	int found = 0;
+	int obj = -1;
+	std::cout << "View size: " << one_view.size() << " / " << many_view.size() << std::endl;
+	std::cout << "View empty: " << one_view.empty() << " / " << many_view.empty() << std::endl;
+	std::cout << "View count (31): " << one_view.count(31) << " / " << many_view.count(31) << std::endl;
+	std::cout << "View count (508): " << one_view.count(508) << " / " << many_view.count(508) << std::endl;
+	found = many_view.find(62, obj);
+	std::cout << "View find (62): " << found << ", " << obj << std::endl;
+	std::cout << "\n";
+  }
+  {
+	testName = "CONCURRENT WRITERS";
+
+	const int threads = 8;
+	stl_map_type stl_map;
+	ft_sharded_map ft_map;
+	shard_writer_args args[threads];
+
+	for (int t = 0; t < threads; t++) {
+	  args[t].map = &ft_map;
+	  args[t].thread = t;
+	  args[t].threads = threads;
+	  args[t].lost_writes = 0;
+	}
+	run_threads(shard_writer_thread, args, sizeof(args[0]), threads);
+	int lost_writes = 0;
+	for (int t = 0; t < threads; t++) {
+	  lost_writes += args[t].lost_writes;
+	  for (int i = 0; i < 2000; i++) {
+		if (i % 3 == 1)
+		  stl_map[i * threads + t] = -i;
+		else if (i % 3 == 2)
+		  stl_map[i * threads + t] = i;
+	  }
+	}
+
+	std::cout << "Writes not seen by their own thread: " << lost_writes << std::endl;
+	printValues(stl_map, ft_map, testName);
+  }
+  {
+	testName = "THREAD SCALING SPEED TEST";
+	std::cout << "\n";
+	std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+	const int total_ops = 256000;
+
+	//одна и та же работа на 1..64 потоках
+	for (int threads = 1; threads <= 64; threads *= 2) {
+	  double time_taken_locked = run_scaling<global_lock_map>(threads, total_ops);
+	  double time_taken_concurrent = run_scaling<ft::concurrent_map<int, int> >(threads, total_ops);
+	  double time_taken_sharded = run_scaling<ft_sharded_map>(threads, total_ops);
+	  std::cout << std::setfill(' ') << std::setw(2) << std::right << threads << std::left << " threads: mutex map time is "
+				<< time_taken_locked << " ms, concurrent map time is " << time_taken_concurrent
+				<< " ms, sharded map time is " << time_taken_sharded << " ms" << std::endl;
+	}
+	std::cout << "\n";
+  }
+}
@@ -0,0 +1,30 @@
+#ifndef TEST_THREADS_HPP
+# define TEST_THREADS_HPP
+
+#include <vector>
+#include <cstddef>
+#include <pthread.h>
+#include <sys/time.h>
+
+// Helpers shared by the tests of the concurrent containers.
+
+// Wall-clock milliseconds: clock() adds up the CPU time of every thread.
+inline double
+wall_ms() {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+// Runs worker on count threads, thread t getting the t-th element of the
+// args array (elements arg_size bytes apart), and waits for all of them.
+inline void
+run_threads(void *(*worker)(void *), void *args, size_t arg_size, int count) {
+  std::vector<pthread_t> threads(count);
+  for (int t = 0; t < count; t++)
+	pthread_create(&threads[t], 0, worker, static_cast<char *>(args) + t * arg_size);
+  for (int t = 0; t < count; t++)
+	pthread_join(threads[t], 0);
+}
+
+#endif
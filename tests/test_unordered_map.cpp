@@ -0,0 +1,261 @@
+#include "../src/unordered_map.hpp"
+#include "../src/map.hpp"
+#include "../src/vector.hpp"
+#include <map>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+template<class Ta, class Tb>
+std::string
+is_equal_content(
+	const std::map<Ta, Tb> &stl_map,
+	const ft::unordered_map<Ta, Tb> &ft_map
+) {
+  typename std::map<Ta, Tb>::const_iterator stl_it;
+  if (ft_map.size() != stl_map.size())
+	return ("NOT EQUAL");
+  for (stl_it = stl_map.begin(); stl_it != stl_map.end(); stl_it++) {
+	typename ft::unordered_map<Ta, Tb>::const_iterator ft_it = ft_map.find((*stl_it).first);
+	if (ft_it == ft_map.end() || (*ft_it).second != (*stl_it).second)
+	  return ("NOT EQUAL");
+  }
+  return ("EQUAL");
+}
+
+template<class Ta, class Tb>
+void
+printValues(
+	std::map<Ta, Tb> &stl_map,
+	ft::unordered_map<Ta, Tb> &ft_map, const std::string &testName
+) {
+  //stl map
+  std::string stl_empty = ((stl_map.empty() == 1) ? "true" : "false");
+  size_t stl_size = stl_map.size();
+
+  //ft unordered map
+  std::string ft_empty = ((ft_map.empty() == 1) ? "true" : "false");
+  size_t ft_size = ft_map.size();
+
+  //сравнение
+  std::string empty = is_equal(ft_empty, stl_empty);
+  std::string size = is_equal(ft_size, stl_size);
+  std::string content = is_equal_content(stl_map, ft_map);
+
+  std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Map";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Unordered";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+  std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+  std::cout << "\n";
+
+  std::cout << std::left << "Result of content comparison: " << content << std::endl;
+  if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+	std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+  else
+	std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+  std::cout << "**********************************************************************" << std::endl;
+}
+
+void
+test_unordered_map() {
+  std::cout << "**********UNORDERED MAP TEST**********\n";
+  std::string testName;
+  const std::string string_array[] = {"one", "two", "three", "four", "five"};
+  const int int_array[] = {1, 2, 3, 4, 5};
+
+  {
+	testName = "DEFAULT CONSTRUCTOR";
+
+	std::map<int, std::string> stl_map;
+	ft::unordered_map<int, std::string> ft_map;
+
+	printValues(stl_map, ft_map, testName);
+  }
+
+  {
+	testName = "INSERT SINGLE";
+
+	std::map<std::string, int> stl_map;
+	ft::unordered_map<std::string, int> ft_map;
+
+	for (int i = 0; i < 5; i++) {
+	  stl_map.insert(std::make_pair(string_array[i], int_array[i]));
+	  ft_map.insert(ft::make_pair(string_array[i], int_array[i]));
+	}
+	stl_map.insert(std::make_pair(string_array[0], 100));
+	ft_map.insert(ft::make_pair(string_array[0], 100));
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "COPY CONSTRUCTOR";
+
+	ft::unordered_map<std::string, int> ft_map_copy(ft_map);
+	std::map<std::string, int> stl_map_copy(stl_map);
+
+	printValues(stl_map_copy, ft_map_copy, testName);
+
+	testName = "OPERATOR []";
+
+	stl_map["six"] = 6;
+	ft_map["six"] = 6;
+	stl_map["two"] += 20;
+	ft_map["two"] += 20;
+
+	printValues(stl_map, ft_map, testName);
+	std::cout << " STL Map[two] = " << stl_map["two"] << std::endl;
+	std::cout << " FT Map[two] = " << ft_map["two"] << std::endl;
+	std::cout << "\n";
+
+	testName = "ERASE KEY";
+
+	stl_map.erase("three");
+	ft_map.erase("three");
+	stl_map.erase("missing");
+	ft_map.erase("missing");
+
+	printValues(stl_map, ft_map, testName);
+
+	testName = "COUNT / AT";
+
+	std::cout << "STL count (four) = " << stl_map.count("four") << std::endl;
+	std::cout << "FT count (four) = " << ft_map.count("four") << std::endl;
+	std::cout << "STL count (three) = " << stl_map.count("three") << std::endl;
+	std::cout << "FT count (three) = " << ft_map.count("three") << std::endl;
+	try {
+	  ft_map.at("three");
+	  std::cout << "FT at (three) did not throw" << std::endl;
+	} catch (std::out_of_range &e) {
+	  std::cout << "FT at (three) threw out_of_range" << std::endl;
+	}
+	std::cout << "\n";
+
+	testName = "SWAP";
+
+	ft::unordered_map<std::string, int> ft_other;
+	std::map<std::string, int> stl_other;
+	ft_other.insert(ft::make_pair(std::string("seven"), 7));
+	stl_other.insert(std::make_pair(std::string("seven"), 7));
+	ft_map.swap(ft_other);
+	stl_map.swap(stl_other);
+
+	printValues(stl_map, ft_map, testName);
+	printValues(stl_other, ft_other, testName);
+  }
+
+  {
+	testName = "INSERT / ERASE MANY";
+
+	std::map<int, int> stl_map;
+	ft::unordered_map<int, int> ft_map;
+
+	for (int i = 0; i < 20000; i++) {
+	  stl_map.insert(std::make_pair(i * 3, i));
+	  ft_map.insert(ft::make_pair(i * 3, i));
+	}
+	for (int i = 0; i < 60000; i += 2) {
+	  stl_map.erase(i);
+	  ft_map.erase(i);
+	}
+	for (int i = 0; i < 5000; i++) {
+	  stl_map.insert(std::make_pair(i * 7, -i));
+	  ft_map.insert(ft::make_pair(i * 7, -i));
+	}
+
+	printValues(stl_map, ft_map, testName);
+
+	size_t walked = 0;
+	for (ft::unordered_map<int, int>::iterator it = ft_map.begin(); it != ft_map.end(); ++it)
+	  walked++;
+	std::cout << "FT iteration visits " << walked << " of " << ft_map.size() << " elements" << std::endl;
+	std::cout << "FT load factor " << ft_map.load_factor() << " of " << ft_map.max_load_factor() << std::endl;
+	std::cout << "\n";
+
+	testName = "CLEAR";
+
+	stl_map.clear();
+	ft_map.clear();
+
+	printValues(stl_map, ft_map, testName);
+  }
+    {
+        testName = "SPEED TEST";
+        std::cout << "\n";
+        std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+        time_t start, end;
+        double time_taken_tree, time_taken_hash;
+        const int count = 200000;
+        ft::vector<int> keys;
+        for (int i = 0; i < count; i++)
+            keys.push_back((int)(((long)i * 7919) % 1000003) * 2);
+
+        ft::map<int, int> tree_map;
+        ft::unordered_map<int, int> hash_map;
+
+        //вставка
+        start = clock();
+        for (int i = 0; i < count; i++)
+            tree_map.insert(ft::make_pair(keys[i], i));
+        end = clock();
+        time_taken_tree = end - start;
+        std::cout << "FT map insertion time is " << time_taken_tree << " ms" << std::endl;
+
+        start = clock();
+        for (int i = 0; i < count; i++)
+            hash_map.insert(ft::make_pair(keys[i], i));
+        end = clock();
+        time_taken_hash = end - start;
+        std::cout << "FT unordered_map insertion time is " << time_taken_hash << " ms" << std::endl;
+        std::cout << "FT unordered_map insertion faster in " << time_taken_tree / time_taken_hash << " times";
+        std::cout << "\n\n";
+
+        //поиск существующих
+        start = clock();
+        for (int i = 0; i < count; i++)
+            tree_map.find(keys[i]);
+        end = clock();
+        time_taken_tree = end - start;
+        std::cout << "FT map hit find time is " << time_taken_tree << " ms" << std::endl;
+
+        start = clock();
+        for (int i = 0; i < count; i++)
+            hash_map.find(keys[i]);
+        end = clock();
+        time_taken_hash = end - start;
+        std::cout << "FT unordered_map hit find time is " << time_taken_hash << " ms" << std::endl;
+        std::cout << "FT unordered_map hit find faster in " << time_taken_tree / time_taken_hash << " times";
+        std::cout << "\n\n";
+
+        //поиск отсутствующих
+        start = clock();
+        for (int i = 0; i < count; i++)
+            tree_map.find(keys[i] + 1);
+        end = clock();
+        time_taken_tree = end - start;
+        std::cout << "FT map miss find time is " << time_taken_tree << " ms" << std::endl;
+
+        start = clock();
+        for (int i = 0; i < count; i++)
+            hash_map.find(keys[i] + 1);
+        end = clock();
+        time_taken_hash = end - start;
+        std::cout << "FT unordered_map miss find time is " << time_taken_hash << " ms" << std::endl;
+        std::cout << "FT unordered_map miss find faster in " << time_taken_tree / time_taken_hash << " times";
+        std::cout << "\n\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "../src/unordered_set.hpp"
+#include <set>
+#include <iostream>
+#include <iomanip>
+
+template<class T>
+std::string
+is_equal(const T &t1, const T &t2) { return t1 == t2 ? "ok" : "not ok"; }
+
+template<class T>
+std::string
+is_equal_content(
+        std::set<T> &stl_set,
+        ft::unordered_set<T> &ft_set
+) {
+    typename std::set<T>::iterator stl_it;
+
+    if (ft_set.size() != stl_set.size())
+        return ("NOT EQUAL");
+    for (stl_it = stl_set.begin(); stl_it != stl_set.end(); stl_it++) {
+        if (!ft_set.count(*stl_it))
+            return ("NOT EQUAL");
+    }
+    return ("EQUAL");
+}
+
+template<class T>
+void
+printValues(
+        std::set<T> &stl_set,
+        ft::unordered_set<T> &ft_set, std::string testName
+) {
+    //real set
+    std::string stl_empty = ((stl_set.empty() == 1) ? "true" : "false");
+    size_t stl_size = stl_set.size();
+
+    //ft unordered set
+    std::string ft_empty = ((ft_set.empty() == 1) ? "true" : "false");
+    size_t ft_size = ft_set.size();
+
+    //сравнение
+    std::string empty = is_equal(ft_empty, stl_empty);
+    std::string size = is_equal(ft_size, stl_size);
+    std::string content = is_equal_content(stl_set, ft_set);
+
+    std::cout << std::setfill('*') << std::setw(70) << std::left << testName << std::endl;
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "Attribute";
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "STL Set";
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "FT Unordered";
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "Result" << std::endl;
+
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "Empty";
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_empty;
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_empty;
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << empty << std::endl;
+
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << "Size";
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << stl_size;
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << ft_size;
+    std::cout << std::setfill(' ') << std::setw(20) << std::left << size << std::endl;
+    std::cout << "\n";
+
+    std::cout << std::left << "Result of content comparison: " << content << std::endl;
+    if (empty == "not ok" || size == "not ok" || content == "NOT EQUAL")
+        std::cout << "\33[1;31m" << "TOTAL: NOT OK" << "\33[1;0m" << std::endl;
+    else
+        std::cout << "\33[1;32m" << "TOTAL: OK" << "\33[1;0m" << std::endl;
+    std::cout << "**********************************************************************" << std::endl;
+}
+
+void
+test_unordered_set() {
+    std::string testName;
+    std::cout << "**********UNORDERED SET TEST**********\n";
+
+    {
+        testName = "DEFAULT INT SET";
+
+        std::set<int> stl_set;
+        ft::unordered_set<int> ft_set;
+
+        printValues(stl_set, ft_set, testName);
+    }
+
+    {
+        testName = "MODIFIERS";
+
+        std::set<std::string> stl_set;
+        ft::unordered_set<std::string> ft_set;
+        const std::string words[] = {"alpha", "beta", "gamma", "delta", "beta"};
+
+        for (int i = 0; i < 5; i++)
+        {
+            stl_set.insert(words[i]);
+            ft_set.insert(words[i]);
+        }
+        printValues(stl_set, ft_set, testName);
+
+        stl_set.erase("gamma");
+        ft_set.erase("gamma");
+        printValues(stl_set, ft_set, testName);
+
+        ft::unordered_set<std::string> ft_copy(ft_set);
+        std::cout << "FT copy == original? " << (ft_copy == ft_set) << std::endl;
+        ft_copy.erase(ft_copy.find("alpha"));
+        std::cout << "FT copy == original after erase? " << (ft_copy == ft_set) << std::endl;
+        std::cout << "\n";
+    }
+
+    {
+        testName = "REHASH";
+
+        std::set<int> stl_set;
+        ft::unordered_set<int> ft_set;
+
+        ft_set.reserve(1000);
+        size_t buckets = ft_set.bucket_count();
+        for (int i = 0; i < 1000; i++)
+        {
+            stl_set.insert(i);
+            ft_set.insert(i);
+        }
+        printValues(stl_set, ft_set, testName);
+        std::cout << "FT bucket count unchanged after reserve? " << (buckets == ft_set.bucket_count()) << std::endl;
+        std::cout << "\n";
+    }
+}
\ No newline at end of file
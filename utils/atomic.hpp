@@ -0,0 +1,86 @@
+#ifndef ATOMIC_HPP
+# define ATOMIC_HPP
+
+# include <cstddef>
+
+namespace ft
+{
+	// The GCC __atomic builtins behind names, for the lock-free containers.
+	// T is a word-sized integer or a pointer. Loads acquire and stores
+	// release unless told otherwise; read-modify-writes are sequentially
+	// consistent, which every algorithm here relies on when it publishes a
+	// pointer with one CAS and reads another thread's state with the next.
+	template<class T>
+	inline T atomic_load(const T* p) {
+		return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+	}
+
+	// Load that takes part in the one order of all sequentially consistent
+	// operations, for a thread that must see either another thread's
+	// store or that thread its own.
+	template<class T>
+	inline T atomic_load_seq_cst(const T* p) {
+		return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+	}
+
+	template<class T>
+	inline T atomic_load_relaxed(const T* p) {
+		return __atomic_load_n(p, __ATOMIC_RELAXED);
+	}
+
+	template<class T>
+	inline void atomic_store(T* p, T value) {
+		__atomic_store_n(p, value, __ATOMIC_RELEASE);
+	}
+
+	template<class T>
+	inline void atomic_store_relaxed(T* p, T value) {
+		__atomic_store_n(p, value, __ATOMIC_RELAXED);
+	}
+
+	// Store that is also a full fence: later loads are not moved before it.
+	template<class T>
+	inline void atomic_store_fence(T* p, T value) {
+		__atomic_store_n(p, value, __ATOMIC_SEQ_CST);
+	}
+
+	template<class T>
+	inline T atomic_exchange(T* p, T value) {
+		return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+	}
+
+	// On failure expected is set to the value found.
+	template<class T>
+	inline bool atomic_compare_exchange(T* p, T& expected, T desired) {
+		return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE);
+	}
+
+	template<class T>
+	inline bool atomic_cas(T* p, T expected, T desired) {
+		return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+	}
+
+	template<class T, class U>
+	inline T atomic_fetch_add(T* p, U delta) {
+		return __atomic_fetch_add(p, delta, __ATOMIC_SEQ_CST);
+	}
+
+	template<class T, class U>
+	inline T atomic_fetch_sub(T* p, U delta) {
+		return __atomic_fetch_sub(p, delta, __ATOMIC_SEQ_CST);
+	}
+
+	inline void atomic_thread_fence(void) {
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+
+	// Tells the core it is spinning, so a hyper-thread sibling gets the
+	// pipeline meanwhile.
+	inline void cpu_relax(void) {
+# if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+# endif
+	}
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef FUNCTIONAL_HPP
 # define FUNCTIONAL_HPP
 
+# include <limits>
+# include "type_traits.hpp"
+
 namespace ft
 {
 	template<class Argument1, class Argument2, class Result>
@@ -16,6 +19,98 @@ namespace ft
 			return lhs < rhs;
 		}
 	};
+
+	// Compares any two types with <, so a map keyed by std::string can be
+	// searched with a const char* without building a string per lookup.
+	template<>
+	struct less<void> {
+		typedef void						is_transparent;
+
+		template<class T, class U>
+		bool operator()(const T& lhs, const U& rhs) const {
+			return lhs < rhs;
+		}
+	};
+
+	// Whether Compare declares is_transparent, and so takes lookup keys of
+	// any type it can compare with the key type.
+	template<class Compare>
+	struct is_transparent {
+		template<class U>
+		static char test(typename U::is_transparent*);
+
+		template<class U>
+		static long test(...);
+
+		static const bool value = sizeof(test<Compare>(0)) == sizeof(char);
+	};
+
+	// Return type R of a lookup template taking a K, declared only for
+	// transparent comparators. Naming K keeps the test in overload
+	// resolution instead of failing when the container is instantiated.
+	template<class Compare, class K, class R>
+	struct enable_if_transparent : enable_if<is_transparent<Compare>::value, R> {};
+
+	template<class T>
+	struct equal_to : binary_function<T, T, bool> {
+		bool operator()(const T& lhs, const T& rhs) const {
+			return lhs == rhs;
+		}
+	};
+
+	template<class Pair>
+	struct select_first {
+		typedef typename Pair::first_type	result_type;
+
+		const result_type& operator()(const Pair& pair) const {
+			return pair.first;
+		}
+	};
+
+	template<class T>
+	struct identity {
+		typedef T							result_type;
+
+		const result_type& operator()(const T& value) const {
+			return value;
+		}
+	};
+
+	// Monoids for aggregate trees: an associative operator() with an
+	// identity() element.
+	template<class T>
+	struct sum_monoid : binary_function<T, T, T> {
+		T identity(void) const {
+			return T();
+		}
+
+		T operator()(const T& lhs, const T& rhs) const {
+			return lhs + rhs;
+		}
+	};
+
+	template<class T>
+	struct min_monoid : binary_function<T, T, T> {
+		T identity(void) const {
+			return std::numeric_limits<T>::max();
+		}
+
+		T operator()(const T& lhs, const T& rhs) const {
+			return rhs < lhs ? rhs : lhs;
+		}
+	};
+
+	template<class T>
+	struct max_monoid : binary_function<T, T, T> {
+		T identity(void) const {
+			return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min()
+														: -std::numeric_limits<T>::max();
+		}
+
+		T operator()(const T& lhs, const T& rhs) const {
+			return lhs < rhs ? rhs : lhs;
+		}
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef HASH_HPP
+# define HASH_HPP
+
+# include <cstddef>
+# include <string>
+
+namespace ft
+{
+	// 64-bit finalizer from MurmurHash3: spreads every input bit over the
+	// whole word so both the low bits (probe position) and the high bits
+	// (control tag) of a hash are usable for sequential integer keys.
+	inline std::size_t hash_mix(unsigned long long x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return static_cast<std::size_t>(x);
+	}
+
+	inline std::size_t hash_bytes(const char* bytes, std::size_t len) {
+		unsigned long long h = 14695981039346656037ULL;
+		for (std::size_t i = 0; i < len; ++i) {
+			h ^= static_cast<unsigned char>(bytes[i]);
+			h *= 1099511628211ULL;
+		}
+		return hash_mix(h);
+	}
+
+	template<class T>
+	struct hash_integral {
+		typedef T			argument_type;
+		typedef std::size_t	result_type;
+
+		std::size_t operator()(T value) const {
+			return hash_mix(static_cast<unsigned long long>(value));
+		}
+	};
+
+	template<class T> struct hash;
+	template<> struct hash<bool> : ft::hash_integral<bool> {};
+	template<> struct hash<char> : ft::hash_integral<char> {};
+	template<> struct hash<wchar_t> : ft::hash_integral<wchar_t> {};
+	template<> struct hash<short> : ft::hash_integral<short> {};
+	template<> struct hash<int> : ft::hash_integral<int> {};
+	template<> struct hash<long> : ft::hash_integral<long> {};
+	template<> struct hash<long long> : ft::hash_integral<long long> {};
+	template<> struct hash<unsigned char> : ft::hash_integral<unsigned char> {};
+	template<> struct hash<unsigned short> : ft::hash_integral<unsigned short> {};
+	template<> struct hash<unsigned int> : ft::hash_integral<unsigned int> {};
+	template<> struct hash<unsigned long> : ft::hash_integral<unsigned long> {};
+	template<> struct hash<unsigned long long> : ft::hash_integral<unsigned long long> {};
+
+	template<class T>
+	struct hash<T*> {
+		typedef T*			argument_type;
+		typedef std::size_t	result_type;
+
+		std::size_t operator()(T* ptr) const {
+			return hash_mix(reinterpret_cast<unsigned long long>(ptr));
+		}
+	};
+
+	template<>
+	struct hash<std::string> {
+		typedef std::string	argument_type;
+		typedef std::size_t	result_type;
+
+		std::size_t operator()(const std::string& str) const {
+			return hash_bytes(str.data(), str.size());
+		}
+	};
+}
+
+#endif
\ No newline at end of file
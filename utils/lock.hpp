@@ -0,0 +1,152 @@
+#ifndef LOCK_HPP
+# define LOCK_HPP
+
+# include <cstddef>
+# include <pthread.h>
+
+namespace ft
+{
+	// Bytes per cache line on the targets we build for. Data written by
+	// different threads is kept this far apart so that one thread's writes
+	// do not evict the line another thread is using.
+	const std::size_t cache_line_size = 64;
+
+	// Thin wrappers over the pthread primitives, so the concurrent
+	// containers lock through scoped guards and never leak a held lock
+	// when an element copy throws. None of them is copyable.
+	class mutex {
+	public:
+		mutex(void) {
+			pthread_mutex_init(&_handle, 0);
+		}
+
+		~mutex(void) {
+			pthread_mutex_destroy(&_handle);
+		}
+
+		void lock(void) {
+			pthread_mutex_lock(&_handle);
+		}
+
+		void unlock(void) {
+			pthread_mutex_unlock(&_handle);
+		}
+
+		pthread_mutex_t* native_handle(void) {
+			return &_handle;
+		}
+
+	private:
+		pthread_mutex_t	_handle;
+
+		mutex(const mutex&);
+		mutex& operator=(const mutex&);
+	};
+
+	class condition_variable {
+	public:
+		condition_variable(void) {
+			pthread_cond_init(&_handle, 0);
+		}
+
+		~condition_variable(void) {
+			pthread_cond_destroy(&_handle);
+		}
+
+		// m must be held; it is released while waiting and held again on
+		// return. Wake-ups may be spurious.
+		void wait(ft::mutex& m) {
+			pthread_cond_wait(&_handle, m.native_handle());
+		}
+
+		void notify_all(void) {
+			pthread_cond_broadcast(&_handle);
+		}
+
+	private:
+		pthread_cond_t	_handle;
+
+		condition_variable(const condition_variable&);
+		condition_variable& operator=(const condition_variable&);
+	};
+
+	// Shared for readers, exclusive for writers. glibc defaults to
+	// preferring readers, which lets a steady stream of lookups starve the
+	// writer forever; ask for writer preference where it is available.
+	class rw_lock {
+	public:
+		rw_lock(void) {
+			pthread_rwlockattr_t attr;
+			pthread_rwlockattr_init(&attr);
+# if defined(__GLIBC__)
+			pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+# endif
+			pthread_rwlock_init(&_handle, &attr);
+			pthread_rwlockattr_destroy(&attr);
+		}
+
+		~rw_lock(void) {
+			pthread_rwlock_destroy(&_handle);
+		}
+
+		void lock_shared(void) {
+			pthread_rwlock_rdlock(&_handle);
+		}
+
+		void lock(void) {
+			pthread_rwlock_wrlock(&_handle);
+		}
+
+		void unlock(void) {
+			pthread_rwlock_unlock(&_handle);
+		}
+
+		void unlock_shared(void) {
+			pthread_rwlock_unlock(&_handle);
+		}
+
+	private:
+		pthread_rwlock_t	_handle;
+
+		rw_lock(const rw_lock&);
+		rw_lock& operator=(const rw_lock&);
+	};
+
+	template<class Lock>
+	class lock_guard {
+	public:
+		explicit lock_guard(Lock& lock) : _lock(lock) {
+			_lock.lock();
+		}
+
+		~lock_guard(void) {
+			_lock.unlock();
+		}
+
+	private:
+		Lock&	_lock;
+
+		lock_guard(const lock_guard&);
+		lock_guard& operator=(const lock_guard&);
+	};
+
+	template<class Lock>
+	class shared_lock_guard {
+	public:
+		explicit shared_lock_guard(Lock& lock) : _lock(lock) {
+			_lock.lock_shared();
+		}
+
+		~shared_lock_guard(void) {
+			_lock.unlock_shared();
+		}
+
+	private:
+		Lock&	_lock;
+
+		shared_lock_guard(const shared_lock_guard&);
+		shared_lock_guard& operator=(const shared_lock_guard&);
+	};
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef TYPE_TRAITS_HPP
 # define TYPE_TRAITS_HPP
 
+# include <cstddef>
 # include <limits>
 
 namespace ft
@@ -44,6 +45,36 @@ namespace ft
 	template<> struct is_integral<unsigned int> : ft::true_type {};
 	template<> struct is_integral<unsigned long> : ft::true_type {};
 	template<> struct is_integral<unsigned long long> : ft::true_type {};
+
+	// Whether copying a T cannot throw: trivially copyable, or a copy
+	// constructor declared not to. Asks the compiler, as C++98 has no way.
+	template<class T>
+	struct is_nothrow_copy_constructible : ft::integral_constant<bool, __has_nothrow_copy(T)> {};
+
+	template<class T>
+	struct alignment_probe {
+		char	c;
+		T		t;
+	};
+
+	template<class T>
+	struct alignment_of : ft::integral_constant<std::size_t, sizeof(alignment_probe<T>) - sizeof(T)> {};
+
+	// Fundamental type with the given alignment, for raw storage of a T that
+	// is constructed later.
+	template<std::size_t Align> struct aligned_type { typedef long double type; };
+	template<> struct aligned_type<1> { typedef char type; };
+	template<> struct aligned_type<2> { typedef short type; };
+	template<> struct aligned_type<4> { typedef int type; };
+	template<> struct aligned_type<8> { typedef long long type; };
+
+	template<std::size_t Len, std::size_t Align>
+	struct aligned_storage {
+		union type {
+			unsigned char								data[Len];
+			typename aligned_type<Align>::type			align;
+		};
+	};
 }
 
 